@@ -0,0 +1,2329 @@
+/**
+    \file       benchmark.c
+    \author     Eremin Dmitry (http://github.com/NeonMercury)
+    \date       October, 2026
+    \brief      Throughput benchmarks for the jfes library.
+*/
+
+#include "../jfes.h"
+#include "examples.h"
+
+#ifdef JFES_USE_THREADS
+/* For clock_gettime: processor time grows with threads count. */
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+/* For malloc and free functions. You can use your own memory functions. */
+#include <stdlib.h>
+
+/* For offsetof in the fields tables. */
+#include <stddef.h>
+
+/* Only for output, string and time functions. */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/** Minimal time for one measurement in seconds. */
+#define BENCHMARK_MIN_SECONDS           0.25
+
+/** Benchmark function type. Returns zero if benchmark failed. */
+typedef int (*benchmark_function_t)(int argc, char **argv);
+
+/** Benchmark description. */
+typedef struct benchmark {
+    const char              *name;              /**< Benchmark name. */
+    benchmark_function_t    function;           /**< Benchmark entry point. */
+} benchmark_t;
+
+/** Telemetry record template. One record contains `BENCHMARK_RECORD_TOKENS` tokens. */
+static const char *benchmark_record =
+    "{\"id\":%lu,\"sensor\":\"probe-%lu\",\"values\":[1.5,-2.25,3,4e+2],"
+    "\"meta\":{\"tags\":[\"a\",\"b\"],\"nested\":{\"level\":{\"deep\":true,\"none\":null}}}}";
+
+/** Tokens count in the one telemetry record. */
+#define BENCHMARK_RECORD_TOKENS         25
+
+/**
+    Returns the current processor time in seconds.
+
+    \return         Processor time in seconds.
+*/
+static double benchmark_now(void) {
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+/**
+    Generates a telemetry document: an array of records.
+
+    \param[in]      size                Required document size.
+    \param[out]     length              Generated document length.
+    \param[out]     tokens_count        Tokens count in the generated document.
+
+    \return         Allocated document or NULL if something went wrong.
+*/
+static char *benchmark_generate_telemetry(unsigned long size, jfes_size_t *length, jfes_size_t *tokens_count) {
+    char *json = malloc(size + 256);
+    if (!json) {
+        return NULL;
+    }
+
+    unsigned long offset = 0;
+    unsigned long records = 0;
+
+    json[offset++] = '[';
+    do {
+        if (records > 0) {
+            json[offset++] = ',';
+        }
+        offset += sprintf(json + offset, benchmark_record, records, records % 64);
+        records++;
+    } while (offset + 1 < size);
+    json[offset++] = ']';
+    json[offset] = '\0';
+
+    *length = (jfes_size_t)offset;
+    *tokens_count = (jfes_size_t)(records * BENCHMARK_RECORD_TOKENS + 1);
+    return json;
+}
+
+/**
+    Measures tokenizer throughput on the given document.
+
+    \param[in]      json                JSON data.
+    \param[in]      length              JSON data length.
+    \param[in]      tokens_count        Tokens count in JSON data.
+
+    \return         Throughput in megabytes per second or zero if something went wrong.
+*/
+static double benchmark_tokenize(const char *json, jfes_size_t length, jfes_size_t tokens_count) {
+    jfes_config_t config;
+    config.jfes_malloc = (jfes_malloc_t)malloc;
+    config.jfes_free = free;
+
+    jfes_token_t *tokens = malloc(tokens_count * sizeof(jfes_token_t));
+    if (!tokens) {
+        return 0.0;
+    }
+
+    jfes_parser_t parser;
+    jfes_init_parser(&parser, &config);
+
+    unsigned long iterations = 0;
+    double start = benchmark_now();
+    double elapsed = 0.0;
+    do {
+        jfes_size_t count = tokens_count;
+        if (jfes_status_is_bad(jfes_parse_tokens(&parser, json, length, tokens, &count))) {
+            free(tokens);
+            return 0.0;
+        }
+        iterations++;
+        elapsed = benchmark_now() - start;
+    } while (elapsed < BENCHMARK_MIN_SECONDS);
+
+    free(tokens);
+    return (double)length * iterations / elapsed / (1024.0 * 1024.0);
+}
+
+/**
+    Tokenizer throughput on growing telemetry documents.
+    The cost per byte should not depend on the document size.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional maximal size in megabytes.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_tokens(int argc, char **argv) {
+    unsigned long max_size = 100ul * 1024 * 1024;
+    if (argc > 0) {
+        max_size = strtoul(argv[0], NULL, 10) * 1024 * 1024;
+    }
+
+    printf("%12s %12s %12s %12s\n", "bytes", "tokens", "ns/byte", "MB/s");
+    for (unsigned long size = 1024; size <= max_size; size *= 10) {
+        jfes_size_t length = 0;
+        jfes_size_t tokens_count = 0;
+        char *json = benchmark_generate_telemetry(size, &length, &tokens_count);
+        if (!json) {
+            return 0;
+        }
+
+        double throughput = benchmark_tokenize(json, length, tokens_count);
+        if (throughput == 0.0) {
+            free(json);
+            return 0;
+        }
+
+        printf("%12u %12u %12.3f %12.1f\n", length, tokens_count,
+            1e9 / (throughput * 1024.0 * 1024.0), throughput);
+
+        free(json);
+    }
+
+    return 1;
+}
+
+/**
+    Generates a string-heavy document: log messages and base64 blobs.
+
+    \param[in]      size                Required document size.
+    \param[out]     length              Generated document length.
+    \param[out]     tokens_count        Tokens count in the generated document.
+
+    \return         Allocated document or NULL if something went wrong.
+*/
+static char *benchmark_generate_strings(unsigned long size, jfes_size_t *length, jfes_size_t *tokens_count) {
+    static const char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    char *json = malloc(size + 2048);
+    if (!json) {
+        return NULL;
+    }
+
+    unsigned long offset = 0;
+    unsigned long records = 0;
+
+    json[offset++] = '[';
+    do {
+        if (records > 0) {
+            json[offset++] = ',';
+        }
+        offset += sprintf(json + offset, "{\"level\":\"info\",\"message\":\"request %lu from \\\"client\\\" "
+            "finished in %lu ms, see https://example.com/requests/%lu for the details\",\"blob\":\"",
+            records, records % 1000, records);
+        for (unsigned long i = 0; i < 1024; i++) {
+            json[offset++] = alphabet[(i * 7 + records) % 64];
+        }
+        offset += sprintf(json + offset, "==\"}");
+        records++;
+    } while (offset + 1 < size);
+    json[offset++] = ']';
+    json[offset] = '\0';
+
+    *length = (jfes_size_t)offset;
+    *tokens_count = (jfes_size_t)(records * 7 + 1);
+    return json;
+}
+
+/**
+    Tokenizer throughput on a string-heavy document.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional document size in megabytes.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_strings(int argc, char **argv) {
+    unsigned long size = 16ul * 1024 * 1024;
+    if (argc > 0) {
+        size = strtoul(argv[0], NULL, 10) * 1024 * 1024;
+    }
+
+    jfes_size_t length = 0;
+    jfes_size_t tokens_count = 0;
+    char *json = benchmark_generate_strings(size, &length, &tokens_count);
+    if (!json) {
+        return 0;
+    }
+
+    double throughput = benchmark_tokenize(json, length, tokens_count);
+    free(json);
+    if (throughput == 0.0) {
+        return 0;
+    }
+
+    printf("%12s %12s\n", "bytes", "MB/s");
+    printf("%12u %12.1f\n", length, throughput);
+    return 1;
+}
+
+/**
+    Generates a number-heavy document: arrays of sensor samples with nanosecond timestamps.
+
+    \param[in]      size                Required document size.
+    \param[out]     length              Generated document length.
+    \param[out]     tokens_count        Tokens count in the generated document.
+
+    \return         Allocated document or NULL if something went wrong.
+*/
+static char *benchmark_generate_numbers(unsigned long size, jfes_size_t *length, jfes_size_t *tokens_count) {
+    char *json = malloc(size + 256);
+    if (!json) {
+        return NULL;
+    }
+
+    unsigned long offset = 0;
+    unsigned long samples = 0;
+
+    json[offset++] = '[';
+    do {
+        if (samples > 0) {
+            json[offset++] = ',';
+        }
+        offset += sprintf(json + offset, "[%llu,%lu.%03lu,-%lu.%02lu,%lue-%lu]",
+            1700000000000000000ull + samples * 1000003ull, samples % 1000, (samples * 7) % 1000,
+            samples % 90, (samples * 13) % 100, samples % 9 + 1, samples % 5 + 1);
+        samples++;
+    } while (offset + 1 < size);
+    json[offset++] = ']';
+    json[offset] = '\0';
+
+    *length = (jfes_size_t)offset;
+    *tokens_count = (jfes_size_t)(samples * 5 + 1);
+    return json;
+}
+
+/**
+    Measures value tree building throughput on the given document.
+
+    \param[in]      json                JSON data.
+    \param[in]      length              JSON data length.
+
+    \return         Throughput in megabytes per second or zero if something went wrong.
+*/
+static double benchmark_parse_to_value(const char *json, jfes_size_t length) {
+    jfes_config_t config;
+    config.jfes_malloc = (jfes_malloc_t)malloc;
+    config.jfes_free = free;
+
+    unsigned long iterations = 0;
+    double start = benchmark_now();
+    double elapsed = 0.0;
+    do {
+        jfes_value_t value;
+        if (jfes_status_is_bad(jfes_parse_to_value(&config, json, length, &value))) {
+            return 0.0;
+        }
+        jfes_free_value(&config, &value);
+        iterations++;
+        elapsed = benchmark_now() - start;
+    } while (elapsed < BENCHMARK_MIN_SECONDS);
+
+    return (double)length * iterations / elapsed / (1024.0 * 1024.0);
+}
+
+/**
+    Tokenizer and value tree throughput on a number-heavy document.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional document size in megabytes.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_numbers(int argc, char **argv) {
+    unsigned long size = 16ul * 1024 * 1024;
+    if (argc > 0) {
+        size = strtoul(argv[0], NULL, 10) * 1024 * 1024;
+    }
+
+    jfes_size_t length = 0;
+    jfes_size_t tokens_count = 0;
+    char *json = benchmark_generate_numbers(size, &length, &tokens_count);
+    if (!json) {
+        return 0;
+    }
+
+    double tokens_throughput = benchmark_tokenize(json, length, tokens_count);
+    double value_throughput = benchmark_parse_to_value(json, length);
+    free(json);
+    if (tokens_throughput == 0.0 || value_throughput == 0.0) {
+        return 0;
+    }
+
+    printf("%12s %12s %12s\n", "bytes", "tokens MB/s", "value MB/s");
+    printf("%12u %12.1f %12.1f\n", length, tokens_throughput, value_throughput);
+    return 1;
+}
+
+/** Random doubles count in the doubles benchmark. */
+#define BENCHMARK_DOUBLES_COUNT         1000000
+
+/**
+    Returns the next pseudo-random number (xorshift64).
+
+    \param[in, out] state               Generator state, must be non-zero.
+
+    \return         Pseudo-random number.
+*/
+static unsigned long long benchmark_random(unsigned long long *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/**
+    Generates an array of random doubles printed with 17 digits.
+
+    \param[in]      count               Doubles count.
+    \param[out]     length              Generated document length.
+
+    \return         Allocated document or NULL if something went wrong.
+*/
+static char *benchmark_generate_doubles(jfes_size_t count, jfes_size_t *length) {
+    char *json = malloc(count * 32 + 2);
+    if (!json) {
+        return NULL;
+    }
+
+    unsigned long long state = 88172645463325252ull;
+    jfes_size_t offset = 0;
+    json[offset++] = '[';
+    for (jfes_size_t i = 0; i < count; i++) {
+        double value = 0.0;
+        do {
+            const unsigned long long bits = benchmark_random(&state);
+            memcpy(&value, &bits, sizeof(value));
+        } while (value != value || value - value != 0.0);
+
+        offset += (jfes_size_t)sprintf(json + offset, i > 0 ? ",%.17e" : "%.17e", value);
+    }
+    json[offset++] = ']';
+    json[offset] = '\0';
+
+    *length = offset;
+    return json;
+}
+
+/**
+    Reference decimal to double conversion: multiplies or divides by 10 once per exponent unit.
+    This is how jfes converted doubles before the Eisel-Lemire parser.
+
+    \param[in]      data                Double literal.
+    \param[in]      length              Literal length.
+
+    \return         Double value.
+*/
+static double benchmark_naive_double(const char *data, jfes_size_t length) {
+    jfes_size_t i = 0;
+    int negative = data[0] == '-';
+    if (negative) {
+        i++;
+    }
+
+    double mantissa = 0.0;
+    int exponent = 0;
+    for (; i < length && data[i] >= '0' && data[i] <= '9'; i++) {
+        mantissa = mantissa * 10.0 + (data[i] - '0');
+    }
+    if (i < length && data[i] == '.') {
+        for (i++; i < length && data[i] >= '0' && data[i] <= '9'; i++) {
+            mantissa = mantissa * 10.0 + (data[i] - '0');
+            exponent--;
+        }
+    }
+    if (i < length && (data[i] == 'e' || data[i] == 'E')) {
+        i++;
+        int exponent_sign = 1;
+        if (data[i] == '+' || data[i] == '-') {
+            exponent_sign = data[i] == '-' ? -1 : 1;
+            i++;
+        }
+        int exponent_value = 0;
+        for (; i < length; i++) {
+            exponent_value = exponent_value * 10 + (data[i] - '0');
+        }
+        exponent += exponent_sign * exponent_value;
+    }
+
+    for (; exponent < 0; exponent++) {
+        mantissa /= 10.0;
+    }
+    for (; exponent > 0; exponent--) {
+        mantissa *= 10.0;
+    }
+
+    return negative ? -mantissa : mantissa;
+}
+
+/**
+    Double conversion speed and accuracy on random doubles printed with 17 digits.
+    Compares jfes with the old naive conversion and strtod.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional doubles count.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_doubles(int argc, char **argv) {
+    jfes_size_t count = BENCHMARK_DOUBLES_COUNT;
+    if (argc > 0) {
+        count = (jfes_size_t)strtoul(argv[0], NULL, 10);
+    }
+
+    jfes_size_t length = 0;
+    char *json = benchmark_generate_doubles(count, &length);
+    jfes_token_t *tokens = malloc((count + 1) * sizeof(jfes_token_t));
+    double *expected = malloc(count * sizeof(double));
+    if (!json || !tokens || !expected) {
+        free(json);
+        free(tokens);
+        free(expected);
+        return 0;
+    }
+
+    jfes_config_t config;
+    config.jfes_malloc = (jfes_malloc_t)malloc;
+    config.jfes_free = free;
+
+    jfes_parser_t parser;
+    jfes_init_parser(&parser, &config);
+
+    jfes_size_t tokens_count = count + 1;
+    if (jfes_status_is_bad(jfes_parse_tokens(&parser, json, length, tokens, &tokens_count))) {
+        free(json);
+        free(tokens);
+        free(expected);
+        return 0;
+    }
+
+    for (jfes_size_t i = 0; i < count; i++) {
+        expected[i] = strtod(json + tokens[i + 1].start, NULL);
+    }
+
+    printf("%12s %12s %12s\n", "method", "ns/double", "errors");
+    for (int method = 0; method < 3; method++) {
+        static const char *methods[] = { "naive", "strtod", "jfes" };
+
+        unsigned long errors = 0;
+        unsigned long iterations = 0;
+        double start = benchmark_now();
+        double elapsed = 0.0;
+        do {
+            for (jfes_size_t i = 0; i < count; i++) {
+                const jfes_token_t *token = &tokens[i + 1];
+                double value = 0.0;
+                if (method == 0) {
+                    value = benchmark_naive_double(json + token->start, token->end - token->start);
+                }
+                else if (method == 1) {
+                    value = strtod(json + token->start, NULL);
+                }
+                else {
+                    jfes_tokens_data_t tokens_data = { &config, json, length, tokens + i + 1, 1, 0 };
+                    jfes_get_double(&tokens_data, "", 0, &value);
+                }
+
+                if (iterations == 0 && memcmp(&value, &expected[i], sizeof(value)) != 0) {
+                    errors++;
+                }
+            }
+            iterations++;
+            elapsed = benchmark_now() - start;
+        } while (elapsed < BENCHMARK_MIN_SECONDS);
+
+        printf("%12s %12.1f %12lu\n", methods[method], elapsed * 1e9 / ((double)count * iterations), errors);
+    }
+
+    free(json);
+    free(tokens);
+    free(expected);
+    return 1;
+}
+
+/**
+    Generates an array of random 64-bit integers of all lengths.
+
+    \param[in]      count               Integers count.
+    \param[out]     length              Generated document length.
+
+    \return         Allocated document or NULL if something went wrong.
+*/
+static char *benchmark_generate_integers(jfes_size_t count, jfes_size_t *length) {
+    char *json = malloc(count * 24 + 2);
+    if (!json) {
+        return NULL;
+    }
+
+    unsigned long long state = 88172645463325252ull;
+    jfes_size_t offset = 0;
+    json[offset++] = '[';
+    for (jfes_size_t i = 0; i < count; i++) {
+        const long long value = (long long)(benchmark_random(&state) >> (benchmark_random(&state) % 64));
+        offset += (jfes_size_t)sprintf(json + offset, i > 0 ? ",%lld" : "%lld", (i & 1) ? -value : value);
+    }
+    json[offset++] = ']';
+    json[offset] = '\0';
+
+    *length = offset;
+    return json;
+}
+
+/**
+    Integer conversion speed on random 64-bit integers. Compares jfes with strtoll.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional integers count.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_integers(int argc, char **argv) {
+    jfes_size_t count = BENCHMARK_DOUBLES_COUNT;
+    if (argc > 0) {
+        count = (jfes_size_t)strtoul(argv[0], NULL, 10);
+    }
+
+    jfes_size_t length = 0;
+    char *json = benchmark_generate_integers(count, &length);
+    jfes_token_t *tokens = malloc((count + 1) * sizeof(jfes_token_t));
+    if (!json || !tokens) {
+        free(json);
+        free(tokens);
+        return 0;
+    }
+
+    jfes_config_t config;
+    config.jfes_malloc = (jfes_malloc_t)malloc;
+    config.jfes_free = free;
+
+    jfes_parser_t parser;
+    jfes_init_parser(&parser, &config);
+
+    jfes_size_t tokens_count = count + 1;
+    if (jfes_status_is_bad(jfes_parse_tokens(&parser, json, length, tokens, &tokens_count))) {
+        free(json);
+        free(tokens);
+        return 0;
+    }
+
+    printf("%12s %12s %12s\n", "method", "ns/integer", "errors");
+    for (int method = 0; method < 2; method++) {
+        static const char *methods[] = { "strtoll", "jfes" };
+
+        unsigned long errors = 0;
+        unsigned long iterations = 0;
+        double start = benchmark_now();
+        double elapsed = 0.0;
+        do {
+            for (jfes_size_t i = 0; i < count; i++) {
+                const jfes_token_t *token = &tokens[i + 1];
+                jfes_integer_t value = 0;
+                if (method == 0) {
+                    value = strtoll(json + token->start, NULL, 10);
+                }
+                else {
+                    jfes_tokens_data_t tokens_data = { &config, json, length, tokens + i + 1, 1, 0 };
+                    jfes_get_integer(&tokens_data, "", 0, &value);
+                }
+
+                if (iterations == 0 && value != strtoll(json + token->start, NULL, 10)) {
+                    errors++;
+                }
+            }
+            iterations++;
+            elapsed = benchmark_now() - start;
+        } while (elapsed < BENCHMARK_MIN_SECONDS);
+
+        printf("%12s %12.1f %12lu\n", methods[method], elapsed * 1e9 / ((double)count * iterations), errors);
+    }
+
+    free(json);
+    free(tokens);
+    return 1;
+}
+
+/**
+    Compares two values made of arrays and scalars.
+
+    \param[in]      a                   First value.
+    \param[in]      b                   Second value.
+
+    \return         Count of different scalars.
+*/
+static unsigned long benchmark_compare_values(const jfes_value_t *a, const jfes_value_t *b) {
+    if (a->type != b->type) {
+        return 1;
+    }
+
+    switch (a->type) {
+    case jfes_type_integer:
+        return a->data.int_val != b->data.int_val ? 1 : 0;
+
+    case jfes_type_double:
+        return a->data.double_val != b->data.double_val ? 1 : 0;
+
+    case jfes_type_array:
+    {
+        if (a->data.array_val->count != b->data.array_val->count) {
+            return a->data.array_val->count;
+        }
+
+        unsigned long errors = 0;
+        for (jfes_size_t i = 0; i < a->data.array_val->count; i++) {
+            errors += benchmark_compare_values(a->data.array_val->items[i], b->data.array_val->items[i]);
+        }
+        return errors;
+    }
+
+    default:
+        return 0;
+    }
+}
+
+/**
+    Measures serializer throughput on the given document and checks that the output reads back unchanged.
+
+    \param[in]      name                Document name.
+    \param[in]      json                JSON data.
+    \param[in]      length              JSON data length.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_serialize_document(const char *name, const char *json, jfes_size_t length) {
+    jfes_config_t config;
+    config.jfes_malloc = (jfes_malloc_t)malloc;
+    config.jfes_free = free;
+
+    jfes_value_t value;
+    if (jfes_status_is_bad(jfes_parse_to_value(&config, json, length, &value))) {
+        return 0;
+    }
+
+    const jfes_size_t dump_capacity = length * 2 + 64;
+    char *dump = malloc(dump_capacity);
+    if (!dump) {
+        jfes_free_value(&config, &value);
+        return 0;
+    }
+
+    jfes_size_t dump_size = 0;
+    unsigned long iterations = 0;
+    double start = benchmark_now();
+    double elapsed = 0.0;
+    do {
+        dump_size = dump_capacity;
+        if (jfes_status_is_bad(jfes_value_to_string(&value, dump, &dump_size, 0))) {
+            break;
+        }
+        iterations++;
+        elapsed = benchmark_now() - start;
+    } while (elapsed < BENCHMARK_MIN_SECONDS);
+
+    unsigned long errors = 0;
+    jfes_value_t parsed;
+    if (iterations > 0 && jfes_status_is_good(jfes_parse_to_value(&config, dump, dump_size, &parsed))) {
+        errors = benchmark_compare_values(&value, &parsed);
+        jfes_free_value(&config, &parsed);
+    }
+    else {
+        errors = (unsigned long)-1;
+    }
+
+    jfes_free_value(&config, &value);
+    free(dump);
+    if (iterations == 0) {
+        return 0;
+    }
+
+    printf("%12s %12u %12.1f %12lu\n", name, dump_size,
+        (double)dump_size * iterations / elapsed / (1024.0 * 1024.0), errors);
+    return 1;
+}
+
+/**
+    Serializer throughput on number-dense values: random doubles, sensor samples and 64-bit integers.
+    Every printed number must read back unchanged.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional doubles count.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_serialize(int argc, char **argv) {
+    jfes_size_t count = BENCHMARK_DOUBLES_COUNT;
+    if (argc > 0) {
+        count = (jfes_size_t)strtoul(argv[0], NULL, 10);
+    }
+
+    printf("%12s %12s %12s %12s\n", "document", "bytes", "MB/s", "errors");
+
+    jfes_size_t length = 0;
+    char *json = benchmark_generate_doubles(count, &length);
+    if (!json) {
+        return 0;
+    }
+
+    int result = benchmark_serialize_document("random", json, length);
+    free(json);
+
+    jfes_size_t tokens_count = 0;
+    json = benchmark_generate_numbers((unsigned long)count * 16, &length, &tokens_count);
+    if (!json) {
+        return 0;
+    }
+
+    result = result && benchmark_serialize_document("sensors", json, length);
+    free(json);
+
+    json = benchmark_generate_integers(count, &length);
+    if (!json) {
+        return 0;
+    }
+
+    result = result && benchmark_serialize_document("integers", json, length);
+    free(json);
+    return result;
+}
+
+/** Chunk size for the SAX benchmark: the data is read by small parts. */
+#define BENCHMARK_SAX_CHUNK_SIZE        4096
+
+/** Counts SAX events. */
+static int benchmark_count_event(void *context, jfes_sax_event_t event, const jfes_sax_value_t *value) {
+    (void)event;
+    (void)value;
+    (*(unsigned long*)context)++;
+    return 1;
+}
+
+/**
+    SAX parser throughput on the telemetry document fed by small chunks.
+    Memory use doesn't depend on the document size.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional document size in megabytes.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_sax(int argc, char **argv) {
+    unsigned long size = 100ul * 1024 * 1024;
+    if (argc > 0) {
+        size = strtoul(argv[0], NULL, 10) * 1024 * 1024;
+    }
+
+    jfes_size_t length = 0;
+    jfes_size_t tokens_count = 0;
+    char *json = benchmark_generate_telemetry(size, &length, &tokens_count);
+    if (!json) {
+        return 0;
+    }
+
+    unsigned char levels[8];
+    char buffer[256];
+    jfes_sax_parser_t parser;
+
+    unsigned long events = 0;
+    unsigned long iterations = 0;
+    double start = benchmark_now();
+    double elapsed = 0.0;
+    do {
+        events = 0;
+        jfes_init_sax_parser(&parser, levels, sizeof(levels) * 8, buffer, sizeof(buffer), benchmark_count_event, &events);
+
+        jfes_status_t status = jfes_success;
+        for (jfes_size_t pos = 0; pos < length && jfes_status_is_good(status); pos += BENCHMARK_SAX_CHUNK_SIZE) {
+            jfes_size_t chunk_length = length - pos < BENCHMARK_SAX_CHUNK_SIZE ? length - pos : BENCHMARK_SAX_CHUNK_SIZE;
+            status = jfes_sax_parse(&parser, json + pos, chunk_length);
+        }
+        if (jfes_status_is_good(status)) {
+            status = jfes_sax_finish(&parser);
+        }
+
+        if (jfes_status_is_bad(status)) {
+            free(json);
+            return 0;
+        }
+        iterations++;
+        elapsed = benchmark_now() - start;
+    } while (elapsed < BENCHMARK_MIN_SECONDS);
+
+    double throughput = (double)length * iterations / elapsed / (1024.0 * 1024.0);
+    printf("%12s %12s %12s %12s\n", "bytes", "events", "memory", "MB/s");
+    printf("%12u %12lu %12lu %12.1f\n", length, events,
+        (unsigned long)(sizeof(parser) + sizeof(levels) + sizeof(buffer)), throughput);
+
+    free(json);
+    return throughput > 0.0;
+}
+
+/**
+    Generates a document with a field before and after the telemetry records.
+
+    \param[in]      size                Required size of the records.
+    \param[out]     length              Generated document length.
+    \param[out]     tokens_count        Tokens count in the generated document.
+
+    \return         Allocated document or NULL if something went wrong.
+*/
+static char *benchmark_generate_wrapped(unsigned long size, jfes_size_t *length, jfes_size_t *tokens_count) {
+    jfes_size_t records_length = 0;
+    char *records = benchmark_generate_telemetry(size, &records_length, tokens_count);
+    char *json = records ? malloc(records_length + 128) : NULL;
+    if (!json) {
+        free(records);
+        return NULL;
+    }
+
+    *length = (jfes_size_t)sprintf(json, "{\"version\":3,\"records\":%s,\"footer\":{\"count\":%u}}",
+        records, (*tokens_count - 1) / BENCHMARK_RECORD_TOKENS);
+    *tokens_count += 8;
+
+    free(records);
+    return json;
+}
+
+/**
+    Reads the field of the object by the raw data cursor.
+
+    \param[in]      json                JSON data.
+    \param[in]      length              JSON data length.
+    \param[in]      first               Key in the root object.
+    \param[in]      second              Key in the `first` object or NULL.
+    \param[out]     value               Integer value of the field.
+
+    \return         Count of bytes read or zero if something went wrong.
+*/
+static jfes_size_t benchmark_cursor_read(const char *json, jfes_size_t length, const char *first,
+        const char *second, jfes_integer_t *value) {
+    unsigned char levels[8];
+    jfes_cursor_t cursor;
+    jfes_init_cursor(&cursor, json, length, levels, sizeof(levels) * 8);
+
+    if (jfes_status_is_bad(jfes_cursor_next(&cursor)) || jfes_status_is_bad(jfes_cursor_find(&cursor, first, 0))) {
+        return 0;
+    }
+    if (second && jfes_status_is_bad(jfes_cursor_find(&cursor, second, 0))) {
+        return 0;
+    }
+    if (cursor.event != jfes_sax_value || cursor.value.type != jfes_type_integer) {
+        return 0;
+    }
+
+    *value = cursor.value.value.int_val;
+    return cursor.pos;
+}
+
+/**
+    Reading one field of a large document: tokenizing the whole document
+    against the cursor which reads only the bytes up to the field.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional document size in megabytes.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_cursor(int argc, char **argv) {
+    unsigned long size = 10ul * 1024 * 1024;
+    if (argc > 0) {
+        size = strtoul(argv[0], NULL, 10) * 1024 * 1024;
+    }
+
+    jfes_config_t config;
+    config.jfes_malloc = (jfes_malloc_t)malloc;
+    config.jfes_free = free;
+
+    jfes_size_t length = 0;
+    jfes_size_t tokens_count = 0;
+    char *json = benchmark_generate_wrapped(size, &length, &tokens_count);
+    jfes_token_t *tokens = json ? malloc(tokens_count * sizeof(jfes_token_t)) : NULL;
+    if (!tokens) {
+        free(json);
+        return 0;
+    }
+
+    const char *fields[] = { "/version", "/footer/count" };
+    const char *keys[][2] = { { "version", NULL }, { "footer", "count" } };
+
+    int result = 1;
+    printf("%16s %12s %12s %12s\n", "field", "method", "bytes read", "us/read");
+    for (jfes_size_t i = 0; i < sizeof(fields) / sizeof(fields[0]) && result; i++) {
+        jfes_integer_t expected = 0;
+        jfes_integer_t value = 0;
+
+        unsigned long iterations = 0;
+        double start = benchmark_now();
+        double elapsed = 0.0;
+        do {
+            jfes_parser_t parser;
+            jfes_init_parser(&parser, &config);
+
+            jfes_size_t count = tokens_count;
+            jfes_tokens_data_t tokens_data = { &config, json, length, tokens, 0, 0 };
+            if (jfes_status_is_bad(jfes_parse_tokens(&parser, json, length, tokens, &count))) {
+                result = 0;
+                break;
+            }
+            tokens_data.tokens_count = count;
+
+            if (jfes_status_is_bad(jfes_get_integer(&tokens_data, fields[i], 0, &expected))) {
+                result = 0;
+                break;
+            }
+            iterations++;
+            elapsed = benchmark_now() - start;
+        } while (elapsed < BENCHMARK_MIN_SECONDS);
+        printf("%16s %12s %12u %12.2f\n", fields[i], "tokens", length, elapsed * 1e6 / iterations);
+
+        jfes_size_t bytes_read = 0;
+        iterations = 0;
+        start = benchmark_now();
+        do {
+            bytes_read = benchmark_cursor_read(json, length, keys[i][0], keys[i][1], &value);
+            if (bytes_read == 0 || value != expected) {
+                result = 0;
+                break;
+            }
+            iterations++;
+            elapsed = benchmark_now() - start;
+        } while (elapsed < BENCHMARK_MIN_SECONDS);
+        printf("%16s %12s %12u %12.2f\n", fields[i], "cursor", bytes_read, elapsed * 1e6 / iterations);
+    }
+
+    free(tokens);
+    free(json);
+    return result;
+}
+
+/** Memory stream for the reader benchmark: stands for a pipe or a socket. */
+typedef struct benchmark_stream {
+    const char      *data;
+    jfes_size_t     length;
+    jfes_size_t     pos;
+} benchmark_stream_t;
+
+/** Reads the next bytes of the memory stream. */
+static jfes_size_t benchmark_read_stream(void *context, char *buffer, jfes_size_t size) {
+    benchmark_stream_t *stream = (benchmark_stream_t*)context;
+    jfes_size_t count = stream->length - stream->pos;
+    if (count > size) {
+        count = size;
+    }
+
+    memcpy(buffer, stream->data + stream->pos, count);
+    stream->pos += count;
+    return count;
+}
+
+/**
+    Reading the stream through a fixed window: the SAX parser and the cursor
+    looking for the field at the end of the document. Memory use doesn't depend
+    on the document size.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional document size in megabytes.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_reader(int argc, char **argv) {
+    unsigned long size = 10ul * 1024 * 1024;
+    if (argc > 0) {
+        size = strtoul(argv[0], NULL, 10) * 1024 * 1024;
+    }
+
+    jfes_size_t length = 0;
+    jfes_size_t tokens_count = 0;
+    char *json = benchmark_generate_wrapped(size, &length, &tokens_count);
+    if (!json) {
+        return 0;
+    }
+
+    const jfes_size_t windows[] = { 256, 4096, 65536 };
+    char *window = malloc(windows[sizeof(windows) / sizeof(windows[0]) - 1]);
+    if (!window) {
+        free(json);
+        return 0;
+    }
+
+    const jfes_integer_t expected = (jfes_integer_t)((tokens_count - 9) / BENCHMARK_RECORD_TOKENS);
+    unsigned char levels[8];
+    char buffer[256];
+
+    int result = 1;
+    printf("%12s %12s %12s %12s\n", "method", "window", "memory", "MB/s");
+    for (jfes_size_t i = 0; i < sizeof(windows) / sizeof(windows[0]) && result; i++) {
+        benchmark_stream_t stream = { json, length, 0 };
+
+        unsigned long iterations = 0;
+        double start = benchmark_now();
+        double elapsed = 0.0;
+        do {
+            unsigned long events = 0;
+            jfes_sax_parser_t parser;
+            jfes_init_sax_parser(&parser, levels, sizeof(levels) * 8, buffer, sizeof(buffer), benchmark_count_event, &events);
+
+            stream.pos = 0;
+            if (jfes_status_is_bad(jfes_sax_parse_reader(&parser, benchmark_read_stream, &stream, window, windows[i]))) {
+                result = 0;
+                break;
+            }
+            iterations++;
+            elapsed = benchmark_now() - start;
+        } while (elapsed < BENCHMARK_MIN_SECONDS);
+        printf("%12s %12u %12lu %12.1f\n", "sax", windows[i],
+            (unsigned long)(sizeof(jfes_sax_parser_t) + sizeof(levels) + sizeof(buffer) + windows[i]),
+            (double)length * iterations / elapsed / (1024.0 * 1024.0));
+
+        iterations = 0;
+        start = benchmark_now();
+        do {
+            jfes_cursor_t cursor;
+            stream.pos = 0;
+            jfes_init_reader_cursor(&cursor, benchmark_read_stream, &stream, window, windows[i], levels, sizeof(levels) * 8);
+            if (jfes_status_is_bad(jfes_cursor_next(&cursor)) || jfes_status_is_bad(jfes_cursor_find(&cursor, "footer", 0)) ||
+                jfes_status_is_bad(jfes_cursor_find(&cursor, "count", 0)) || cursor.value.value.int_val != expected) {
+                result = 0;
+                break;
+            }
+            iterations++;
+            elapsed = benchmark_now() - start;
+        } while (elapsed < BENCHMARK_MIN_SECONDS);
+        printf("%12s %12u %12lu %12.1f\n", "cursor", windows[i],
+            (unsigned long)(sizeof(jfes_cursor_t) + sizeof(levels) + windows[i]),
+            (double)length * iterations / elapsed / (1024.0 * 1024.0));
+    }
+
+    free(window);
+    free(json);
+    return result;
+}
+
+/**
+    Generates separate telemetry records, one after another.
+
+    \param[in]      records             Records count.
+    \param[out]     offsets             Allocated array of `records` + 1 record offsets.
+
+    \return         Allocated records or NULL if something went wrong.
+*/
+static char *benchmark_generate_records(unsigned long records, jfes_size_t **offsets) {
+    char *json = malloc(records * 256);
+    *offsets = json ? malloc((records + 1) * sizeof(jfes_size_t)) : NULL;
+    if (!*offsets) {
+        free(json);
+        return NULL;
+    }
+
+    (*offsets)[0] = 0;
+    for (unsigned long record = 0; record < records; record++) {
+        (*offsets)[record + 1] = (*offsets)[record] +
+            (jfes_size_t)sprintf(json + (*offsets)[record], benchmark_record, record, record % 64);
+    }
+
+    return json;
+}
+
+/** Counts path matches. */
+static int benchmark_count_match(void *context, jfes_size_t path, const jfes_cursor_t *cursor) {
+    (void)path;
+    (void)cursor;
+    (*(unsigned long*)context)++;
+    return 1;
+}
+
+/**
+    Finds the value by the JSON Pointer in the value tree with jfes_get_child.
+
+    \param[in]      value               Root value.
+    \param[in]      pointer             JSON Pointer without escapes.
+
+    \return         Found value or NULL.
+*/
+static jfes_value_t *benchmark_find_child(jfes_value_t *value, const char *pointer) {
+    while (value && *pointer == '/') {
+        const char *reference = ++pointer;
+        while (*pointer != '\0' && *pointer != '/') {
+            pointer++;
+        }
+
+        if (value->type == jfes_type_object) {
+            value = jfes_get_child(value, reference, (jfes_size_t)(pointer - reference));
+        }
+        else if (value->type == jfes_type_array) {
+            unsigned long index = strtoul(reference, NULL, 10);
+            value = index < value->data.array_val->count ? value->data.array_val->items[index] : NULL;
+        }
+        else {
+            value = NULL;
+        }
+    }
+
+    return value;
+}
+
+/** Document with escaped keys: the paths see them decoded. */
+static const char *benchmark_escaped_keys = "{\"q\\u0031\":3,\"\\u00e9\\/\":{\"x\":[true]}}";
+
+/**
+    Checks that the paths see the escaped keys decoded as jfes_parse_to_value does.
+
+    \param[in]      config              JFES configuration.
+
+    \return         Zero if the check failed. Anything otherwise.
+*/
+static int benchmark_check_escaped_keys(const jfes_config_t *config) {
+    const char *json = benchmark_escaped_keys;
+    const jfes_size_t length = (jfes_size_t)strlen(json);
+
+    jfes_path_node_t nodes[8];
+    int states[8];
+    jfes_matcher_t matcher;
+    jfes_init_matcher(&matcher, nodes, sizeof(nodes) / sizeof(nodes[0]));
+    jfes_matcher_add(&matcher, "/q1", 0, JFES_NULL);
+    jfes_matcher_add(&matcher, "/\xc3\xa9~1/x/0", 0, JFES_NULL);
+
+    jfes_token_t tokens[16];
+    jfes_size_t count = sizeof(tokens) / sizeof(tokens[0]);
+    jfes_parser_t parser;
+    jfes_init_parser(&parser, config);
+    if (jfes_status_is_bad(jfes_parse_tokens(&parser, json, length, tokens, &count))) {
+        return 0;
+    }
+
+    /* RFC 6901 has only the ~0 and ~1 escapes. */
+    jfes_tokens_data_t tokens_data = { config, json, length, tokens, count, 0 };
+    jfes_integer_t value = 0;
+    if (jfes_status_is_bad(jfes_get_integer(&tokens_data, "/q1", 0, &value)) || value != 3 ||
+            jfes_get_integer(&tokens_data, "/q~2", 0, &value) != jfes_invalid_arguments ||
+            jfes_get_integer(&tokens_data, "/q~", 0, &value) != jfes_invalid_arguments ||
+            jfes_matcher_add(&matcher, "/q~", 0, JFES_NULL) != jfes_invalid_arguments) {
+        return 0;
+    }
+
+    unsigned char levels[1];
+    unsigned long matches = 0;
+    jfes_cursor_t cursor;
+    jfes_init_tokens_cursor(&cursor, json, length, tokens, count);
+    if (jfes_status_is_bad(jfes_match(&matcher, &cursor, states, benchmark_count_match, &matches))) {
+        return 0;
+    }
+    jfes_init_cursor(&cursor, json, length, levels, sizeof(levels) * 8);
+    if (jfes_status_is_bad(jfes_match(&matcher, &cursor, states, benchmark_count_match, &matches))) {
+        return 0;
+    }
+
+    return matches == 4;
+}
+
+/**
+    Extracting the same paths from every telemetry record: a lookup per path
+    in the value tree or the tokens against one pass of the compiled matcher
+    over the tokens and the raw data.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional records count.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_paths(int argc, char **argv) {
+    unsigned long records = 100000;
+    if (argc > 0) {
+        records = strtoul(argv[0], NULL, 10);
+    }
+
+    jfes_config_t config;
+    config.jfes_malloc = (jfes_malloc_t)malloc;
+    config.jfes_free = free;
+
+    const char *paths[] = { "/id", "/sensor", "/values/0", "/values/2", "/values/3", "/meta/tags/0",
+        "/meta/tags/1", "/meta/nested/level/deep", "/meta/nested/level/none", "/meta/missing" };
+    const jfes_size_t paths_count = sizeof(paths) / sizeof(paths[0]);
+
+    if (!benchmark_check_escaped_keys(&config)) {
+        printf("escaped keys are not matched\n");
+        return 0;
+    }
+
+    jfes_path_node_t nodes[32];
+    int states[32];
+    jfes_matcher_t matcher;
+    jfes_init_matcher(&matcher, nodes, sizeof(nodes) / sizeof(nodes[0]));
+    for (jfes_size_t i = 0; i < paths_count; i++) {
+        if (jfes_status_is_bad(jfes_matcher_add(&matcher, paths[i], 0, JFES_NULL))) {
+            return 0;
+        }
+    }
+
+    jfes_size_t *offsets = NULL;
+    char *json = benchmark_generate_records(records, &offsets);
+    if (!json) {
+        return 0;
+    }
+
+    jfes_token_t tokens[BENCHMARK_RECORD_TOKENS];
+    unsigned char levels[8];
+    const char *methods[] = { "values", "pointers", "tokens", "raw" };
+
+    int result = 1;
+    printf("%12s %12s %12s\n", "method", "matches", "ns/record");
+    for (jfes_size_t method = 0; method < sizeof(methods) / sizeof(methods[0]) && result; method++) {
+        unsigned long matches = 0;
+        double start = benchmark_now();
+        for (unsigned long record = 0; record < records && result; record++) {
+            const char *data = json + offsets[record];
+            const jfes_size_t length = offsets[record + 1] - offsets[record];
+
+            if (method == 0) {
+                jfes_value_t value;
+                if (jfes_status_is_bad(jfes_parse_to_value(&config, data, length, &value))) {
+                    result = 0;
+                    break;
+                }
+                for (jfes_size_t i = 0; i < paths_count; i++) {
+                    if (benchmark_find_child(&value, paths[i])) {
+                        matches++;
+                    }
+                }
+                jfes_free_value(&config, &value);
+                continue;
+            }
+
+            jfes_size_t count = BENCHMARK_RECORD_TOKENS;
+            if (method < 3) {
+                jfes_parser_t parser;
+                jfes_init_parser(&parser, &config);
+                if (jfes_status_is_bad(jfes_parse_tokens(&parser, data, length, tokens, &count))) {
+                    result = 0;
+                    break;
+                }
+            }
+
+            jfes_cursor_t cursor;
+            if (method == 1) {
+                jfes_tokens_data_t tokens_data = { &config, data, length, tokens, count, 0 };
+                for (jfes_size_t i = 0; i < paths_count; i++) {
+                    jfes_size_t index = 0;
+                    if (jfes_status_is_good(jfes_find_token(&tokens_data, paths[i], 0, &index))) {
+                        matches++;
+                    }
+                }
+                continue;
+            }
+            else if (method == 2) {
+                jfes_init_tokens_cursor(&cursor, data, length, tokens, count);
+            }
+            else {
+                jfes_init_cursor(&cursor, data, length, levels, sizeof(levels) * 8);
+            }
+
+            if (jfes_status_is_bad(jfes_match(&matcher, &cursor, states, benchmark_count_match, &matches))) {
+                result = 0;
+            }
+        }
+        double elapsed = benchmark_now() - start;
+
+        result = result && matches == records * (paths_count - 1);
+        printf("%12s %12lu %12.1f\n", methods[method], matches, elapsed * 1e9 / records);
+    }
+
+    free(offsets);
+    free(json);
+    return result;
+}
+
+/** Telemetry record decoded into C structs. */
+typedef struct benchmark_record_struct {
+    jfes_integer_t  id;
+    char            sensor[16];
+    double          values[4];
+    jfes_size_t     values_count;
+    char            tags[4][8];
+    jfes_size_t     tags_count;
+    int             deep;
+} benchmark_record_struct_t;
+
+/** Fields of the `level` object: stored right in the record. */
+static const jfes_field_t benchmark_level_fields[] = {
+    { "deep",   offsetof(benchmark_record_struct_t, deep),      jfes_field_boolean, NULL, 0, 0, 0 },
+    { NULL,     0,                                              jfes_field_boolean, NULL, 0, 0, 0 },
+};
+
+/** Fields of the `nested` object. */
+static const jfes_field_t benchmark_nested_fields[] = {
+    { "level",  0,  jfes_field_object,  benchmark_level_fields, 0, 0, 0 },
+    { NULL,     0,  jfes_field_boolean, NULL,                   0, 0, 0 },
+};
+
+/** Fields of the `meta` object. */
+static const jfes_field_t benchmark_meta_fields[] = {
+    { "tags",   offsetof(benchmark_record_struct_t, tags),      jfes_field_string,  NULL,                       8, 4,
+        offsetof(benchmark_record_struct_t, tags_count) },
+    { "nested", 0,                                              jfes_field_object,  benchmark_nested_fields,    0, 0, 0 },
+    { NULL,     0,                                              jfes_field_boolean, NULL,                       0, 0, 0 },
+};
+
+/** Fields of the telemetry record. Nested objects have zero offsets: they are flattened into the record. */
+static const jfes_field_t benchmark_record_fields[] = {
+    { "id",     offsetof(benchmark_record_struct_t, id),        jfes_field_integer, NULL,                   0, 0, 0 },
+    { "sensor", offsetof(benchmark_record_struct_t, sensor),    jfes_field_string,  NULL,                   16, 0, 0 },
+    { "values", offsetof(benchmark_record_struct_t, values),    jfes_field_double,  NULL,                   0, 4,
+        offsetof(benchmark_record_struct_t, values_count) },
+    { "meta",   0,                                              jfes_field_object,  benchmark_meta_fields,  0, 0, 0 },
+    { NULL,     0,                                              jfes_field_boolean, NULL,                   0, 0, 0 },
+};
+
+/**
+    Copies the telemetry record from the value tree into the struct.
+
+    \param[in]      value               Record value.
+    \param[out]     record              Record struct.
+
+    \return         Non-zero if everything is OK.
+*/
+static int benchmark_copy_record(const jfes_value_t *value, benchmark_record_struct_t *record) {
+    jfes_value_t *id = jfes_get_child(value, "id", 0);
+    jfes_value_t *sensor = jfes_get_child(value, "sensor", 0);
+    jfes_value_t *values = jfes_get_child(value, "values", 0);
+    jfes_value_t *meta = jfes_get_child(value, "meta", 0);
+    jfes_value_t *tags = meta ? jfes_get_child(meta, "tags", 0) : NULL;
+    jfes_value_t *nested = meta ? jfes_get_child(meta, "nested", 0) : NULL;
+    jfes_value_t *level = nested ? jfes_get_child(nested, "level", 0) : NULL;
+    jfes_value_t *deep = level ? jfes_get_child(level, "deep", 0) : NULL;
+    if (!id || !sensor || !values || !tags || !deep || sensor->data.string_val.size >= sizeof(record->sensor) ||
+        values->data.array_val->count > 4 || tags->data.array_val->count > 4) {
+        return 0;
+    }
+
+    record->id = id->data.int_val;
+    memcpy(record->sensor, sensor->data.string_val.data, sensor->data.string_val.size + 1);
+    record->values_count = values->data.array_val->count;
+    for (jfes_size_t i = 0; i < record->values_count; i++) {
+        const jfes_value_t *item = values->data.array_val->items[i];
+        record->values[i] = item->type == jfes_type_integer ? (double)item->data.int_val : item->data.double_val;
+    }
+    record->tags_count = tags->data.array_val->count;
+    for (jfes_size_t i = 0; i < record->tags_count; i++) {
+        const jfes_string_t *tag = &tags->data.array_val->items[i]->data.string_val;
+        if (tag->size >= sizeof(record->tags[i])) {
+            return 0;
+        }
+        memcpy(record->tags[i], tag->data, tag->size + 1);
+    }
+    record->deep = deep->data.bool_val;
+    return 1;
+}
+
+/**
+    Decoding every telemetry record into a C struct: through the value tree
+    against jfes_read_struct over the raw data.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional records count.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_struct(int argc, char **argv) {
+    unsigned long records = 100000;
+    if (argc > 0) {
+        records = strtoul(argv[0], NULL, 10);
+    }
+
+    jfes_config_t config;
+    config.jfes_malloc = (jfes_malloc_t)malloc;
+    config.jfes_free = free;
+
+    jfes_size_t *offsets = NULL;
+    char *json = benchmark_generate_records(records, &offsets);
+    if (!json) {
+        return 0;
+    }
+
+    unsigned char levels[8];
+    const char *methods[] = { "values", "struct" };
+
+    int result = 1;
+    printf("%12s %12s\n", "method", "ns/record");
+    for (jfes_size_t method = 0; method < sizeof(methods) / sizeof(methods[0]) && result; method++) {
+        jfes_integer_t checksum = 0;
+        double start = benchmark_now();
+        for (unsigned long record = 0; record < records && result; record++) {
+            const char *data = json + offsets[record];
+            const jfes_size_t length = offsets[record + 1] - offsets[record];
+
+            benchmark_record_struct_t decoded;
+            memset(&decoded, 0, sizeof(decoded));
+
+            if (method == 0) {
+                jfes_value_t value;
+                if (jfes_status_is_bad(jfes_parse_to_value(&config, data, length, &value))) {
+                    result = 0;
+                    break;
+                }
+                result = benchmark_copy_record(&value, &decoded);
+                jfes_free_value(&config, &value);
+            }
+            else {
+                jfes_cursor_t cursor;
+                jfes_init_cursor(&cursor, data, length, levels, sizeof(levels) * 8);
+                result = jfes_status_is_good(jfes_read_struct(&cursor, benchmark_record_fields, &decoded));
+            }
+
+            result = result && decoded.values_count == 4 && decoded.tags_count == 2 && decoded.deep;
+            checksum += decoded.id;
+        }
+        double elapsed = benchmark_now() - start;
+
+        result = result && checksum == (jfes_integer_t)(records * (records - 1) / 2);
+        printf("%12s %12.1f\n", methods[method], elapsed * 1e9 / records);
+    }
+
+    free(offsets);
+    free(json);
+    return result;
+}
+
+/** Allocations count of benchmark_counting_malloc. */
+static unsigned long benchmark_allocations = 0;
+
+/** malloc which counts allocations. */
+static void *benchmark_counting_malloc(jfes_size_t size) {
+    benchmark_allocations++;
+    return malloc(size);
+}
+
+/**
+    Checks that the projection sees the escaped keys decoded as jfes_parse_to_value does.
+
+    \param[in]      config              JFES configuration.
+
+    \return         Zero if the check failed. Anything otherwise.
+*/
+static int benchmark_check_escaped_projection(const jfes_config_t *config) {
+    jfes_path_node_t nodes[8];
+    jfes_matcher_t matcher;
+    jfes_init_matcher(&matcher, nodes, sizeof(nodes) / sizeof(nodes[0]));
+    jfes_matcher_add(&matcher, "/q1", 0, JFES_NULL);
+    jfes_matcher_add(&matcher, "/\xc3\xa9~1/x", 0, JFES_NULL);
+
+    jfes_value_t value;
+    if (jfes_status_is_bad(jfes_parse_to_projected_value(config, benchmark_escaped_keys,
+            (jfes_size_t)strlen(benchmark_escaped_keys), &matcher, &value))) {
+        return 0;
+    }
+
+    const int result = value.data.object_val->count == 2 && jfes_get_child(&value, "q1", 0) &&
+        jfes_get_child(&value, "\xc3\xa9/", 0);
+    jfes_free_value(config, &value);
+    return result;
+}
+
+/** Sections count of the projection benchmark document. */
+#define BENCHMARK_PROJECTION_SECTIONS   40
+
+/**
+    Reading a few sections of a large config: building all values against
+    building only the projected ones. Two sections of forty are read, 5% of the content.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional document size in megabytes.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_projection(int argc, char **argv) {
+    unsigned long size = 2ul * 1024 * 1024;
+    if (argc > 0) {
+        size = strtoul(argv[0], NULL, 10) * 1024 * 1024;
+    }
+
+    jfes_config_t config;
+    config.jfes_malloc = (jfes_malloc_t)benchmark_counting_malloc;
+    config.jfes_free = free;
+
+    if (!benchmark_check_escaped_projection(&config)) {
+        printf("escaped keys are not projected\n");
+        return 0;
+    }
+
+    /* Config document: an object of sections, each one is an array of telemetry records. */
+    const unsigned long section_size = size / BENCHMARK_PROJECTION_SECTIONS;
+    char *json = malloc(size + BENCHMARK_PROJECTION_SECTIONS * 512);
+    if (!json) {
+        return 0;
+    }
+
+    jfes_size_t length = 0;
+    json[length++] = '{';
+    for (unsigned long section = 0; section < BENCHMARK_PROJECTION_SECTIONS; section++) {
+        jfes_size_t section_length = 0;
+        jfes_size_t tokens_count = 0;
+        char *records = benchmark_generate_telemetry(section_size, &section_length, &tokens_count);
+        if (!records) {
+            free(json);
+            return 0;
+        }
+
+        length += (jfes_size_t)sprintf(json + length, "%s\"section%lu\":", section > 0 ? "," : "", section);
+        memcpy(json + length, records, section_length);
+        length += section_length;
+        free(records);
+    }
+    json[length++] = '}';
+    json[length] = '\0';
+
+    jfes_path_node_t nodes[3];
+    jfes_matcher_t matcher;
+    jfes_init_matcher(&matcher, nodes, sizeof(nodes) / sizeof(nodes[0]));
+    jfes_matcher_add(&matcher, "/section7", 0, JFES_NULL);
+    jfes_matcher_add(&matcher, "/section31", 0, JFES_NULL);
+    const unsigned long paths_count = matcher.paths_count;
+    const unsigned long sections = BENCHMARK_PROJECTION_SECTIONS;
+
+    const char *methods[] = { "values", "projected" };
+
+    int result = 1;
+    printf("%12s %12s %12s %12s\n", "method", "sections", "allocations", "ms/document");
+    for (jfes_size_t method = 0; method < sizeof(methods) / sizeof(methods[0]) && result; method++) {
+        unsigned long built = 0;
+        unsigned long allocations = 0;
+
+        unsigned long iterations = 0;
+        double start = benchmark_now();
+        double elapsed = 0.0;
+        do {
+            benchmark_allocations = 0;
+
+            jfes_value_t value;
+            jfes_status_t status = method == 0 ? jfes_parse_to_value(&config, json, length, &value) :
+                jfes_parse_to_projected_value(&config, json, length, &matcher, &value);
+            if (jfes_status_is_bad(status)) {
+                result = 0;
+                break;
+            }
+
+            built = value.data.object_val->count;
+            allocations = benchmark_allocations;
+            jfes_free_value(&config, &value);
+
+            iterations++;
+            elapsed = benchmark_now() - start;
+        } while (elapsed < BENCHMARK_MIN_SECONDS);
+
+        result = result && built == (method == 0 ? sections : paths_count);
+        printf("%12s %12lu %12lu %12.2f\n", methods[method], built, allocations, elapsed * 1e3 / iterations);
+    }
+
+    free(json);
+    return result;
+}
+
+/** Maximal nesting depth of the validate benchmark. */
+#define BENCHMARK_VALIDATE_DEPTH        64
+
+/**
+    Measures validator throughput on the given document.
+
+    \param[in]      json                JSON data.
+    \param[in]      length              JSON data length.
+
+    \return         Throughput in megabytes per second or zero if something went wrong.
+*/
+static double benchmark_validate_document(const char *json, jfes_size_t length) {
+    unsigned char levels[(BENCHMARK_VALIDATE_DEPTH + 7) / 8];
+
+    unsigned long iterations = 0;
+    double start = benchmark_now();
+    double elapsed = 0.0;
+    do {
+        if (jfes_validate(json, length, levels, BENCHMARK_VALIDATE_DEPTH) != jfes_success) {
+            return 0.0;
+        }
+        iterations++;
+        elapsed = benchmark_now() - start;
+    } while (elapsed < BENCHMARK_MIN_SECONDS);
+
+    return (double)length * iterations / elapsed / (1024.0 * 1024.0);
+}
+
+/**
+    Accepting a document: full tokenization against validation only,
+    on the telemetry and string-heavy documents. Throughputs are in megabytes per second.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional document size in megabytes.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_validate(int argc, char **argv) {
+    unsigned long size = 16ul * 1024 * 1024;
+    if (argc > 0) {
+        size = strtoul(argv[0], NULL, 10) * 1024 * 1024;
+    }
+
+    const char *documents[] = { "telemetry", "strings" };
+
+    printf("%12s %12s %12s %12s\n", "document", "bytes", "tokenize", "validate");
+    for (int document = 0; document < 2; document++) {
+        jfes_size_t length = 0;
+        jfes_size_t tokens_count = 0;
+        char *json = document == 0 ? benchmark_generate_telemetry(size, &length, &tokens_count)
+            : benchmark_generate_strings(size, &length, &tokens_count);
+        if (!json) {
+            return 0;
+        }
+
+        const double tokenized = benchmark_tokenize(json, length, tokens_count);
+        const double validated = benchmark_validate_document(json, length);
+        free(json);
+        if (tokenized == 0.0 || validated == 0.0) {
+            return 0;
+        }
+
+        printf("%12s %12u %12.1f %12.1f\n", documents[document], length, tokenized, validated);
+    }
+
+    return 1;
+}
+
+/** Multilingual message of the text benchmark document: Cyrillic, CJK, emoji and ASCII. */
+static const char *benchmark_text =
+    "\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82, \xd0\xbc\xd0\xb8\xd1\x80! "
+    "\xe4\xbd\xa0\xe5\xa5\xbd\xef\xbc\x8c\xe4\xb8\x96\xe7\x95\x8c \xf0\x9f\x98\x80 "
+    "order shipped to M\xc3\xbcnchen, \xe2\x82\xac" "42.50 paid";
+
+/**
+    Generates a document of multilingual messages.
+
+    \param[in]      size                Required document size.
+    \param[out]     length              Generated document length.
+    \param[out]     tokens_count        Tokens count in the generated document.
+
+    \return         Allocated document or NULL if something went wrong.
+*/
+static char *benchmark_generate_text(unsigned long size, jfes_size_t *length, jfes_size_t *tokens_count) {
+    char *json = malloc(size + 512);
+    if (!json) {
+        return NULL;
+    }
+
+    unsigned long offset = 0;
+    unsigned long records = 0;
+
+    json[offset++] = '[';
+    do {
+        if (records > 0) {
+            json[offset++] = ',';
+        }
+        offset += sprintf(json + offset, "{\"user\":\"user%lu\",\"text\":\"%s #%lu\"}", records, benchmark_text, records);
+        records++;
+    } while (offset + 1 < size);
+    json[offset++] = ']';
+    json[offset] = '\0';
+
+    *length = (jfes_size_t)offset;
+    *tokens_count = (jfes_size_t)(records * 5 + 1);
+    return json;
+}
+
+/**
+    Checks UTF-8 byte by byte, as a separate pass over the whole document.
+
+    \param[in]      data                Data to check.
+    \param[in]      length              Data length.
+
+    \return         Non-zero if the data is valid.
+*/
+static int benchmark_naive_utf8(const char *data, jfes_size_t length) {
+    const unsigned char *bytes = (const unsigned char*)data;
+    jfes_size_t i = 0;
+    while (i < length) {
+        unsigned long code_point = bytes[i];
+        jfes_size_t count = 0;
+        if (code_point >= 0xF0) {
+            code_point &= 0x07;
+            count = 3;
+        }
+        else if (code_point >= 0xE0) {
+            code_point &= 0x0F;
+            count = 2;
+        }
+        else if (code_point >= 0xC0) {
+            code_point &= 0x1F;
+            count = 1;
+        }
+        else if (code_point >= 0x80) {
+            return 0;
+        }
+
+        if (count >= length - i) {
+            return 0;
+        }
+        for (jfes_size_t j = 1; j <= count; j++) {
+            if ((bytes[i + j] & 0xC0) != 0x80) {
+                return 0;
+            }
+            code_point = (code_point << 6) | (bytes[i + j] & 0x3F);
+        }
+
+        static const unsigned long min_code_points[] = { 0, 0x80, 0x800, 0x10000 };
+        if (code_point < min_code_points[count] || code_point > 0x10FFFF ||
+            (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+            return 0;
+        }
+        i += count + 1;
+    }
+
+    return 1;
+}
+
+/**
+    Tokenizer throughput on a multilingual document against a separate byte by byte
+    UTF-8 pass over it. Build with and without JFES_VALIDATE_UTF8 to see the cost of
+    the checks in the tokenizer.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional document size in megabytes.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_utf8(int argc, char **argv) {
+    unsigned long size = 16ul * 1024 * 1024;
+    if (argc > 0) {
+        size = strtoul(argv[0], NULL, 10) * 1024 * 1024;
+    }
+
+    jfes_size_t length = 0;
+    jfes_size_t tokens_count = 0;
+    char *json = benchmark_generate_text(size, &length, &tokens_count);
+    if (!json) {
+        return 0;
+    }
+
+    const double tokenized = benchmark_tokenize(json, length, tokens_count);
+
+    unsigned long iterations = 0;
+    double start = benchmark_now();
+    double elapsed = 0.0;
+    do {
+        if (!benchmark_naive_utf8(json, length)) {
+            free(json);
+            return 0;
+        }
+        iterations++;
+        elapsed = benchmark_now() - start;
+    } while (elapsed < BENCHMARK_MIN_SECONDS);
+    free(json);
+
+    if (tokenized == 0.0) {
+        return 0;
+    }
+
+#ifdef JFES_VALIDATE_UTF8
+    const char *checks = "on";
+#else
+    const char *checks = "off";
+#endif
+    printf("%12s %12s %12s\n", "bytes", "tokenize", "utf-8 pass");
+    printf("%12u %12.1f %12.1f MB/s, checks in the tokenizer are %s\n", length, tokenized,
+        (double)length * iterations / elapsed / (1024.0 * 1024.0), checks);
+    return 1;
+}
+
+/**
+    Generates a document of messages with escape sequences.
+
+    \param[in]      size                Required document size.
+    \param[in]      every               Characters count between escape sequences, zero for no escapes.
+    \param[out]     length              Generated document length.
+    \param[out]     tokens_count        Tokens count in the generated document.
+
+    \return         Allocated document or NULL if something went wrong.
+*/
+static char *benchmark_generate_escaped(unsigned long size, unsigned long every, jfes_size_t *length,
+        jfes_size_t *tokens_count) {
+    static const char *escapes[] = { "\\n", "\\\"", "\\u00e9", "\\\\", "\\uD83D\\uDE00", "\\t" };
+
+    char *json = malloc(size + 1024);
+    if (!json) {
+        return NULL;
+    }
+
+    unsigned long offset = 0;
+    unsigned long records = 0;
+
+    json[offset++] = '[';
+    do {
+        if (records > 0) {
+            json[offset++] = ',';
+        }
+        offset += sprintf(json + offset, "{\"message\":\"");
+        for (unsigned long i = 0; i < 256; i++) {
+            if (every > 0 && i % every == every - 1) {
+                offset += sprintf(json + offset, "%s", escapes[(records + i) % 6]);
+            }
+            else {
+                json[offset++] = (char)('a' + (records + i) % 26);
+            }
+        }
+        offset += sprintf(json + offset, "\"}");
+        records++;
+    } while (offset + 1 < size);
+    json[offset++] = ']';
+    json[offset] = '\0';
+
+    *length = (jfes_size_t)offset;
+    *tokens_count = (jfes_size_t)(records * 3 + 1);
+    return json;
+}
+
+/**
+    Value tree throughput on string-heavy documents with no, rare and frequent escape sequences.
+    Strings are decoded while the values are built.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional document size in megabytes.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_escapes(int argc, char **argv) {
+    unsigned long size = 16ul * 1024 * 1024;
+    if (argc > 0) {
+        size = strtoul(argv[0], NULL, 10) * 1024 * 1024;
+    }
+
+    const unsigned long every[] = { 0, 64, 4 };
+
+    printf("%12s %12s %12s %12s\n", "escape every", "bytes", "tokens MB/s", "value MB/s");
+    for (int i = 0; i < 3; i++) {
+        jfes_size_t length = 0;
+        jfes_size_t tokens_count = 0;
+        char *json = benchmark_generate_escaped(size, every[i], &length, &tokens_count);
+        if (!json) {
+            return 0;
+        }
+
+        const double tokens_throughput = benchmark_tokenize(json, length, tokens_count);
+        const double value_throughput = benchmark_parse_to_value(json, length);
+        free(json);
+        if (tokens_throughput == 0.0 || value_throughput == 0.0) {
+            return 0;
+        }
+
+        printf("%12lu %12u %12.1f %12.1f\n", every[i], length, tokens_throughput, value_throughput);
+    }
+
+    return 1;
+}
+
+/**
+    Building values of a key-heavy telemetry document: allocated strings against in-situ ones.
+    The document is copied before every parse because in-situ parsing changes it.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional document size in megabytes.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_in_situ(int argc, char **argv) {
+    unsigned long size = 8ul * 1024 * 1024;
+    if (argc > 0) {
+        size = strtoul(argv[0], NULL, 10) * 1024 * 1024;
+    }
+
+    jfes_config_t config;
+    config.jfes_malloc = (jfes_malloc_t)benchmark_counting_malloc;
+    config.jfes_free = free;
+
+    jfes_size_t length = 0;
+    jfes_size_t tokens_count = 0;
+    char *json = benchmark_generate_telemetry(size, &length, &tokens_count);
+    char *copy = malloc(length);
+    if (!json || !copy) {
+        free(json);
+        free(copy);
+        return 0;
+    }
+
+    const char *methods[] = { "allocated", "in situ" };
+
+    int result = 1;
+    unsigned long records[2] = { 0, 0 };
+    printf("%12s %12s %12s %12s\n", "method", "records", "allocations", "ms/document");
+    for (jfes_size_t method = 0; method < sizeof(methods) / sizeof(methods[0]) && result; method++) {
+        unsigned long allocations = 0;
+
+        unsigned long iterations = 0;
+        double start = benchmark_now();
+        double elapsed = 0.0;
+        do {
+            memcpy(copy, json, length);
+            benchmark_allocations = 0;
+
+            jfes_value_t value;
+            jfes_status_t status = method == 0 ? jfes_parse_to_value(&config, copy, length, &value) :
+                jfes_parse_to_value_in_situ(&config, copy, length, &value);
+            if (jfes_status_is_bad(status)) {
+                result = 0;
+                break;
+            }
+
+            records[method] = value.data.array_val->count;
+            allocations = benchmark_allocations;
+            jfes_free_value(&config, &value);
+
+            iterations++;
+            elapsed = benchmark_now() - start;
+        } while (elapsed < BENCHMARK_MIN_SECONDS);
+
+        printf("%12s %12lu %12lu %12.2f\n", methods[method], records[method], allocations, elapsed * 1e3 / iterations);
+    }
+
+    free(copy);
+    free(json);
+    return result && records[0] == records[1];
+}
+
+#ifdef JFES_USE_MMAP
+/** Temporary file for the file loading benchmark. */
+#define BENCHMARK_FILENAME              "~tmp_benchmark.json"
+
+/**
+    Loads and tokenizes the file: read into the buffer or mapped.
+
+    \param[in]      mapped              Non-zero to map the file, zero to read it.
+    \param[in]      length              File length.
+    \param[in, out] tokens              Tokens array.
+    \param[in]      tokens_count        Tokens count in the file.
+
+    \return         Non-zero if everything is OK.
+*/
+static int benchmark_load_file(int mapped, jfes_size_t length, jfes_token_t *tokens, jfes_size_t tokens_count) {
+    jfes_config_t config;
+    config.jfes_malloc = (jfes_malloc_t)malloc;
+    config.jfes_free = free;
+
+    jfes_parser_t parser;
+    jfes_init_parser(&parser, &config);
+
+    jfes_size_t count = tokens_count;
+    int result = 0;
+
+    if (mapped) {
+        jfes_mapped_file_t file;
+        if (jfes_status_is_bad(jfes_map_file(BENCHMARK_FILENAME, &file))) {
+            return 0;
+        }
+
+        result = jfes_status_is_good(jfes_parse_tokens(&parser, file.data, file.length, tokens, &count));
+        jfes_unmap_file(&file);
+    }
+    else {
+        char *json = malloc(length);
+        FILE *f = fopen(BENCHMARK_FILENAME, "rb");
+        if (json && f && fread(json, 1, length, f) == length) {
+            result = jfes_status_is_good(jfes_parse_tokens(&parser, json, length, tokens, &count));
+        }
+
+        if (f) {
+            fclose(f);
+        }
+        free(json);
+    }
+
+    return result && count == tokens_count;
+}
+
+/**
+    File loading: read into a buffer against memory mapping.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional file size in megabytes.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_mmap(int argc, char **argv) {
+    unsigned long size = 100ul * 1024 * 1024;
+    if (argc > 0) {
+        size = strtoul(argv[0], NULL, 10) * 1024 * 1024;
+    }
+
+    jfes_size_t length = 0;
+    jfes_size_t tokens_count = 0;
+    char *json = benchmark_generate_telemetry(size, &length, &tokens_count);
+    jfes_token_t *tokens = json ? malloc(tokens_count * sizeof(jfes_token_t)) : NULL;
+    int result = tokens && set_file_content(BENCHMARK_FILENAME, json, length) == (int)length;
+    free(json);
+
+    printf("%12s %12s %12s\n", "method", "bytes", "MB/s");
+    for (int mapped = 0; mapped <= 1 && result; mapped++) {
+        unsigned long iterations = 0;
+        double start = benchmark_now();
+        double elapsed = 0.0;
+        do {
+            if (!benchmark_load_file(mapped, length, tokens, tokens_count)) {
+                result = 0;
+                break;
+            }
+            iterations++;
+            elapsed = benchmark_now() - start;
+        } while (elapsed < BENCHMARK_MIN_SECONDS);
+
+        if (result) {
+            printf("%12s %12u %12.1f\n", mapped ? "mmap" : "fread", length,
+                (double)length * iterations / elapsed / (1024.0 * 1024.0));
+        }
+    }
+
+    remove(BENCHMARK_FILENAME);
+    free(tokens);
+    return result;
+}
+#endif
+
+#ifdef JFES_USE_THREADS
+/**
+    Returns the monotonic wall clock time in seconds.
+
+    \return         Wall clock time in seconds.
+*/
+static double benchmark_wall_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+/**
+    Measures parallel tokenizer throughput on the given document by the wall clock
+    and checks that tokens are the same as the sequential ones.
+
+    \param[in]      json                JSON data.
+    \param[in]      length              JSON data length.
+    \param[in]      expected            Tokens of the sequential parser.
+    \param[in]      tokens_count        Tokens count in JSON data.
+    \param[in]      threads_count       Threads count. Zero means the sequential parser.
+
+    \return         Throughput in megabytes per second or zero if something went wrong.
+*/
+static double benchmark_tokenize_parallel(const char *json, jfes_size_t length, const jfes_token_t *expected,
+        jfes_size_t tokens_count, jfes_size_t threads_count) {
+    jfes_config_t config;
+    config.jfes_malloc = (jfes_malloc_t)malloc;
+    config.jfes_free = free;
+
+    jfes_token_t *tokens = malloc(tokens_count * sizeof(jfes_token_t));
+    if (!tokens) {
+        return 0.0;
+    }
+
+    jfes_parser_t parser;
+    jfes_init_parser(&parser, &config);
+
+    unsigned long iterations = 0;
+    double start = benchmark_wall_now();
+    double elapsed = 0.0;
+    do {
+        jfes_size_t count = tokens_count;
+        jfes_status_t status = threads_count == 0
+            ? jfes_parse_tokens(&parser, json, length, tokens, &count)
+            : jfes_parse_tokens_parallel(&parser, json, length, tokens, &count, threads_count);
+        if (jfes_status_is_bad(status) || count != tokens_count) {
+            free(tokens);
+            return 0.0;
+        }
+        iterations++;
+        elapsed = benchmark_wall_now() - start;
+    } while (elapsed < BENCHMARK_MIN_SECONDS);
+
+    for (jfes_size_t i = 0; i < tokens_count; i++) {
+        if (tokens[i].type != expected[i].type || tokens[i].start != expected[i].start ||
+            tokens[i].end != expected[i].end || tokens[i].size != expected[i].size ||
+            tokens[i].parent != expected[i].parent) {
+            printf("Token %u differs from the sequential one.\n", i);
+            free(tokens);
+            return 0.0;
+        }
+    }
+
+    free(tokens);
+    return (double)length * iterations / elapsed / (1024.0 * 1024.0);
+}
+
+/**
+    Parallel tokenizer throughput on a large telemetry document.
+    Speedup is limited by the count of processor cores.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional document size in megabytes.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_parallel(int argc, char **argv) {
+    unsigned long size = 100ul * 1024 * 1024;
+    if (argc > 0) {
+        size = strtoul(argv[0], NULL, 10) * 1024 * 1024;
+    }
+
+    jfes_config_t config;
+    config.jfes_malloc = (jfes_malloc_t)malloc;
+    config.jfes_free = free;
+
+    jfes_size_t length = 0;
+    jfes_size_t tokens_count = 0;
+    char *json = benchmark_generate_telemetry(size, &length, &tokens_count);
+    jfes_token_t *expected = malloc(tokens_count * sizeof(jfes_token_t));
+    if (!json || !expected) {
+        free(json);
+        free(expected);
+        return 0;
+    }
+
+    jfes_parser_t parser;
+    jfes_init_parser(&parser, &config);
+
+    jfes_size_t count = tokens_count;
+    int result = jfes_status_is_good(jfes_parse_tokens(&parser, json, length, expected, &count));
+
+    double sequential = 0.0;
+    printf("%12s %12s %12s\n", "threads", "MB/s", "speedup");
+    for (jfes_size_t threads_count = 0; result && threads_count <= 8; threads_count = threads_count ? threads_count * 2 : 1) {
+        double throughput = benchmark_tokenize_parallel(json, length, expected, tokens_count, threads_count);
+        if (throughput == 0.0) {
+            result = 0;
+            break;
+        }
+
+        if (threads_count == 0) {
+            sequential = throughput;
+            printf("%12s %12.1f %12.2f\n", "sequential", throughput, 1.0);
+        }
+        else {
+            printf("%12u %12.1f %12.2f\n", threads_count, throughput, throughput / sequential);
+        }
+    }
+
+    free(expected);
+    free(json);
+    return result;
+}
+/**
+    Generates JSON Lines: one telemetry record per line.
+
+    \param[in]      count               Records count.
+    \param[out]     length              Generated data length.
+
+    \return         Allocated data or NULL if something went wrong.
+*/
+static char *benchmark_generate_lines(unsigned long count, jfes_size_t *length) {
+    char *json = malloc(count * (strlen(benchmark_record) + 64) + 1);
+    if (!json) {
+        return NULL;
+    }
+
+    unsigned long offset = 0;
+    for (unsigned long i = 0; i < count; i++) {
+        offset += sprintf(json + offset, benchmark_record, i, i % 64);
+        json[offset++] = '\n';
+    }
+    json[offset] = '\0';
+
+    *length = (jfes_size_t)offset;
+    return json;
+}
+
+/** Checks the records order: the record `id` must be equal to its index. */
+static int benchmark_check_record(void *context, jfes_size_t index, jfes_status_t status, jfes_value_t *value) {
+    unsigned long *errors = (unsigned long*)context;
+
+    jfes_value_t *id = value ? jfes_get_child(value, "id", 0) : NULL;
+    if (jfes_status_is_bad(status) || !id || id->type != jfes_type_integer || id->data.int_val != (jfes_integer_t)index) {
+        (*errors)++;
+    }
+    return 1;
+}
+
+/**
+    JSON Lines throughput: a loop of jfes_parse_to_value calls against
+    jfes_parse_lines on the growing worker pool.
+
+    \param[in]      argc                Arguments count.
+    \param[in]      argv                Arguments. The first one is optional records count.
+
+    \return         Zero if benchmark failed. Anything otherwise.
+*/
+static int benchmark_lines(int argc, char **argv) {
+    unsigned long count = 200000;
+    if (argc > 0) {
+        count = strtoul(argv[0], NULL, 10);
+    }
+
+    jfes_config_t config;
+    config.jfes_malloc = (jfes_malloc_t)malloc;
+    config.jfes_free = free;
+
+    jfes_size_t length = 0;
+    char *json = benchmark_generate_lines(count, &length);
+    if (!json) {
+        return 0;
+    }
+
+    double start = benchmark_wall_now();
+    for (char *line = json; *line != '\0';) {
+        char *end = strchr(line, '\n');
+
+        jfes_value_t value;
+        if (jfes_status_is_bad(jfes_parse_to_value(&config, line, (jfes_size_t)(end - line), &value))) {
+            free(json);
+            return 0;
+        }
+        jfes_free_value(&config, &value);
+
+        line = end + 1;
+    }
+    double sequential = count / (benchmark_wall_now() - start);
+
+    printf("%12s %12s %12s\n", "threads", "records/s", "speedup");
+    printf("%12s %12.0f %12.2f\n", "loop", sequential, 1.0);
+
+    int result = 1;
+    for (jfes_size_t threads_count = 1; threads_count <= 8; threads_count *= 2) {
+        unsigned long errors = 0;
+        jfes_lines_stats_t stats;
+        if (jfes_status_is_bad(jfes_parse_lines(&config, json, length, threads_count, benchmark_check_record, &errors, &stats))
+            || errors != 0 || stats.records_count != count) {
+            result = 0;
+            break;
+        }
+
+        printf("%12u %12.0f %12.2f\n", threads_count, stats.records_per_second, stats.records_per_second / sequential);
+    }
+
+    free(json);
+    return result;
+}
+#endif
+
+/** All available benchmarks. */
+static const benchmark_t benchmarks[] = {
+    { "tokens",     benchmark_tokens },
+    { "strings",    benchmark_strings },
+    { "numbers",    benchmark_numbers },
+    { "doubles",    benchmark_doubles },
+    { "integers",   benchmark_integers },
+    { "serialize",  benchmark_serialize },
+    { "sax",        benchmark_sax },
+    { "cursor",     benchmark_cursor },
+    { "reader",     benchmark_reader },
+    { "paths",      benchmark_paths },
+    { "struct",     benchmark_struct },
+    { "projection", benchmark_projection },
+    { "validate",   benchmark_validate },
+    { "utf8",       benchmark_utf8 },
+    { "escapes",    benchmark_escapes },
+    { "insitu",     benchmark_in_situ },
+#ifdef JFES_USE_MMAP
+    { "mmap",       benchmark_mmap },
+#endif
+#ifdef JFES_USE_THREADS
+    { "parallel",   benchmark_parallel },
+    { "lines",      benchmark_lines },
+#endif
+};
+
+/** Benchmark entry point. */
+int benchmark_entry(int argc, char **argv) {
+    const jfes_size_t benchmarks_count = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    for (jfes_size_t i = 0; i < benchmarks_count; i++) {
+        if (argc > 1 && strcmp(argv[1], benchmarks[i].name) != 0) {
+            continue;
+        }
+
+        printf("== %s ==\n", benchmarks[i].name);
+        if (!benchmarks[i].function(argc > 2 ? argc - 2 : 0, argv + 2)) {
+            printf("Benchmark `%s` failed.\n", benchmarks[i].name);
+            return -1;
+        }
+    }
+
+    return 0;
+}
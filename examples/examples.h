@@ -17,6 +17,9 @@ int example_2_entry(int argc, char **argv);
 /** Entry point for example_3. */
 int example_3_entry(int argc, char **argv);
 
+/** Entry point for benchmarks. */
+int benchmark_entry(int argc, char **argv);
+
 /**
     Helper function. Saves file content.
 
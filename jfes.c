@@ -7,27 +7,56 @@
 
 #include "jfes.h"
 
-/** Needed for the buffer in jfes_(int/double)_to_string(_r). */
-#define JFES_MAX_DIGITS                 64
+#if defined(JFES_USE_THREADS) || defined(JFES_USE_MMAP)
+/* For clock_gettime, mmap and posix_madvise. Must be defined before any system header. */
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#ifdef JFES_USE_THREADS
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#ifdef JFES_USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef JFES_USE_SIMD
+#if defined(__AVX2__)
+#define JFES_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JFES_SSE2
+#include <emmintrin.h>
+#endif
+#endif
+
+/** JSON has no octal and hexadecimal literals. */
+#if defined(JFES_STRICT) && !defined(JFES_DECIMAL_ONLY)
+#define JFES_DECIMAL_ONLY
+#endif
 
-/** Needed for the default precision in jfes_double_to_string(_r). */
-#define JFES_DOUBLE_PRECISION           0.000000001
+/** Needed for the buffer of jfes_double_to_string_r. */
+#define JFES_MAX_DIGITS                 64
 
 /** Needed for the boolean-related functions */
 #define JFES_TRUE_VALUE                 "true"
 #define JFES_FALSE_VALUE                "false"
 
-/** Needed for the jfes_is_null function */
+/** Needed for the jfes_read_primitive function */
 #define JFES_NULL_VALUE                 "null"
 
-/** Integer types */
-typedef enum jfes_integer_type {
-    jfes_not_integer                = 0x00,     /**< String can't be interpreted as integer. */
-    jfes_octal_integer              = 0x08,     /**< Octal integer (starts from zero: `023` = `19`) */
-    jfes_decimal_integer            = 0x0A,     /**< Decimal integer */
-    jfes_hexadecimal_integer        = 0x10,     /**< Hexadecimal integer (mask: `0x...` or `0X...`) */
-    
-} jfes_integer_type_t;
+/** Size of the block classified at once by jfes_classify_block. */
+#define JFES_BLOCK_SIZE                 64
+
+/** Maximal count of threads used by jfes_parse_tokens_parallel. */
+#define JFES_MAX_THREADS                64
+
+/** Minimal size of the data parsed by one thread. */
+#define JFES_MIN_CHUNK_SIZE             65536
 
 /** Stream helper. */
 typedef struct jfes_stringstream {
@@ -77,6 +106,32 @@ static void *jfes_memcpy(void *dst, const void *src, jfes_size_t count) {
     return dst;
 }
 
+/**
+    Copies memory. Supports overlapping.
+
+    \param[out]     dst                 Output memory block.
+    \param[in]      src                 Input memory block.
+    \param[in]      count               Bytes count to copy.
+
+    \return         Pointer to the destination memory.
+*/
+static void *jfes_memmove(void *dst, const void *src, jfes_size_t count) {
+    unsigned char *destination  = (unsigned char *)dst;
+    unsigned char *source       = (unsigned char *)src;
+    if (destination < source) {
+        while (count-- > 0) {
+            *(destination++) = *(source++);
+        }
+    }
+    else {
+        while (count-- > 0) {
+            destination[count] = source[count];
+        }
+    }
+
+    return dst;
+}
+
 /**
     Checks configuration object and its members.
 
@@ -111,6 +166,7 @@ static jfes_status_t jfes_allocate_string(const jfes_config_t *config, jfes_stri
     }
 
     str->size = size;
+    str->borrowed = 0;
 
     return status;
 }
@@ -130,7 +186,9 @@ static jfes_status_t jfes_free_string(const jfes_config_t *config, jfes_string_t
 
     if (str->size > 0) {
         str->size = 0;
-        config->jfes_free(str->data);
+        if (!str->borrowed) {
+            config->jfes_free(str->data);
+        }
         str->data = JFES_NULL;
     }
 
@@ -148,7 +206,7 @@ static jfes_status_t jfes_free_string(const jfes_config_t *config, jfes_string_t
     \return         jfes_success if everything is OK.
 */
 static jfes_status_t jfes_create_string(const jfes_config_t *config, jfes_string_t *str, const char *string, jfes_size_t size) {
-    if (!jfes_check_configuration(config) || !str || !string || size == 0) {
+    if (!jfes_check_configuration(config) || !str || !string) {
         return jfes_invalid_arguments;
     }
 
@@ -180,516 +238,1945 @@ static jfes_size_t jfes_strlen(const char *data) {
 }
 
 /**
-    Analyzes input string on the subject of whether it's equal to "null".
+    Returns value of the hexadecimal digit.
 
-    \param[in]      data                Input string.
-    \param[in]      length              Optional. String length. You can pass zero
-                                        if `data` is a null-terminated string.
+    \param[in]      c                   Character to convert.
 
-    \return         Zero if input string is not equal to "null". Otherwise anything.
+    \return         Digit value or -1 if the character is not a hexadecimal digit.
 */
-static int jfes_is_null(const char *data, jfes_size_t length) {
-    if (!data) {
-        return 0;
+static int jfes_hex_digit_value(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
     }
-
-    if (length == 0) {
-        length = jfes_strlen(data);
+    else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
     }
 
-    return length == jfes_strlen(JFES_NULL_VALUE) && jfes_memcmp(data, JFES_NULL_VALUE, length) == 0;
+    return -1;
 }
 
-/**
-    Analyzes input string on the subject of whether it is boolean.
+/** Minimal decimal exponent in jfes_powers_of_ten. */
+#define JFES_POWERS_OF_TEN_MIN          -342
 
-    \param[in]      data                Input string.
-    \param[in]      length              Optional. String length. You can pass zero
-                                        if `data` is a null-terminated string.
+/** Maximal decimal exponent in jfes_powers_of_ten. */
+#define JFES_POWERS_OF_TEN_MAX          308
 
-    \return         Zero if input string is not boolean. Otherwise anything.
-*/
-static int jfes_is_boolean(const char *data, jfes_size_t length) {
-    if (!data) {
-        return 0;
-    }
+/** Maximal count of significant digits accumulated in the 64-bit mantissa. */
+#define JFES_MANTISSA_DIGITS            19
 
-    if (length == 0) {
-        length = jfes_strlen(data);
-    }
+/** Maximal count of digits in jfes_decimal_t. Enough for the exact double conversion. */
+#define JFES_DECIMAL_DIGITS             800
 
-    return length == jfes_strlen(JFES_TRUE_VALUE) && jfes_memcmp(data, JFES_TRUE_VALUE, length) == 0 ||
-           length == jfes_strlen(JFES_FALSE_VALUE) && jfes_memcmp(data, JFES_FALSE_VALUE, length) == 0;
-}
+/** Maximal binary shift of jfes_decimal_t at once. */
+#define JFES_DECIMAL_MAX_SHIFT          60
+
+/** Maximal count of digits added by the one jfes_decimal_t left shift. */
+#define JFES_DECIMAL_SHIFT_DIGITS       19
+
+/**
+    128-bit approximations (rounded down) of the powers of ten from 1e-342 to 1e308.
+    Each one is normalized so that the most significant bit is set: { high bits, low bits }.
+*/
+static const unsigned long long jfes_powers_of_ten[][2] = {
+    { 0xEEF453D6923BD65AULL, 0x113FAA2906A13B3FULL },
+    { 0x9558B4661B6565F8ULL, 0x4AC7CA59A424C507ULL },
+    { 0xBAAEE17FA23EBF76ULL, 0x5D79BCF00D2DF649ULL },
+    { 0xE95A99DF8ACE6F53ULL, 0xF4D82C2C107973DCULL },
+    { 0x91D8A02BB6C10594ULL, 0x79071B9B8A4BE869ULL },
+    { 0xB64EC836A47146F9ULL, 0x9748E2826CDEE284ULL },
+    { 0xE3E27A444D8D98B7ULL, 0xFD1B1B2308169B25ULL },
+    { 0x8E6D8C6AB0787F72ULL, 0xFE30F0F5E50E20F7ULL },
+    { 0xB208EF855C969F4FULL, 0xBDBD2D335E51A935ULL },
+    { 0xDE8B2B66B3BC4723ULL, 0xAD2C788035E61382ULL },
+    { 0x8B16FB203055AC76ULL, 0x4C3BCB5021AFCC31ULL },
+    { 0xADDCB9E83C6B1793ULL, 0xDF4ABE242A1BBF3DULL },
+    { 0xD953E8624B85DD78ULL, 0xD71D6DAD34A2AF0DULL },
+    { 0x87D4713D6F33AA6BULL, 0x8672648C40E5AD68ULL },
+    { 0xA9C98D8CCB009506ULL, 0x680EFDAF511F18C2ULL },
+    { 0xD43BF0EFFDC0BA48ULL, 0x0212BD1B2566DEF2ULL },
+    { 0x84A57695FE98746DULL, 0x014BB630F7604B57ULL },
+    { 0xA5CED43B7E3E9188ULL, 0x419EA3BD35385E2DULL },
+    { 0xCF42894A5DCE35EAULL, 0x52064CAC828675B9ULL },
+    { 0x818995CE7AA0E1B2ULL, 0x7343EFEBD1940993ULL },
+    { 0xA1EBFB4219491A1FULL, 0x1014EBE6C5F90BF8ULL },
+    { 0xCA66FA129F9B60A6ULL, 0xD41A26E077774EF6ULL },
+    { 0xFD00B897478238D0ULL, 0x8920B098955522B4ULL },
+    { 0x9E20735E8CB16382ULL, 0x55B46E5F5D5535B0ULL },
+    { 0xC5A890362FDDBC62ULL, 0xEB2189F734AA831DULL },
+    { 0xF712B443BBD52B7BULL, 0xA5E9EC7501D523E4ULL },
+    { 0x9A6BB0AA55653B2DULL, 0x47B233C92125366EULL },
+    { 0xC1069CD4EABE89F8ULL, 0x999EC0BB696E840AULL },
+    { 0xF148440A256E2C76ULL, 0xC00670EA43CA250DULL },
+    { 0x96CD2A865764DBCAULL, 0x380406926A5E5728ULL },
+    { 0xBC807527ED3E12BCULL, 0xC605083704F5ECF2ULL },
+    { 0xEBA09271E88D976BULL, 0xF7864A44C633682EULL },
+    { 0x93445B8731587EA3ULL, 0x7AB3EE6AFBE0211DULL },
+    { 0xB8157268FDAE9E4CULL, 0x5960EA05BAD82964ULL },
+    { 0xE61ACF033D1A45DFULL, 0x6FB92487298E33BDULL },
+    { 0x8FD0C16206306BABULL, 0xA5D3B6D479F8E056ULL },
+    { 0xB3C4F1BA87BC8696ULL, 0x8F48A4899877186CULL },
+    { 0xE0B62E2929ABA83CULL, 0x331ACDABFE94DE87ULL },
+    { 0x8C71DCD9BA0B4925ULL, 0x9FF0C08B7F1D0B14ULL },
+    { 0xAF8E5410288E1B6FULL, 0x07ECF0AE5EE44DD9ULL },
+    { 0xDB71E91432B1A24AULL, 0xC9E82CD9F69D6150ULL },
+    { 0x892731AC9FAF056EULL, 0xBE311C083A225CD2ULL },
+    { 0xAB70FE17C79AC6CAULL, 0x6DBD630A48AAF406ULL },
+    { 0xD64D3D9DB981787DULL, 0x092CBBCCDAD5B108ULL },
+    { 0x85F0468293F0EB4EULL, 0x25BBF56008C58EA5ULL },
+    { 0xA76C582338ED2621ULL, 0xAF2AF2B80AF6F24EULL },
+    { 0xD1476E2C07286FAAULL, 0x1AF5AF660DB4AEE1ULL },
+    { 0x82CCA4DB847945CAULL, 0x50D98D9FC890ED4DULL },
+    { 0xA37FCE126597973CULL, 0xE50FF107BAB528A0ULL },
+    { 0xCC5FC196FEFD7D0CULL, 0x1E53ED49A96272C8ULL },
+    { 0xFF77B1FCBEBCDC4FULL, 0x25E8E89C13BB0F7AULL },
+    { 0x9FAACF3DF73609B1ULL, 0x77B191618C54E9ACULL },
+    { 0xC795830D75038C1DULL, 0xD59DF5B9EF6A2417ULL },
+    { 0xF97AE3D0D2446F25ULL, 0x4B0573286B44AD1DULL },
+    { 0x9BECCE62836AC577ULL, 0x4EE367F9430AEC32ULL },
+    { 0xC2E801FB244576D5ULL, 0x229C41F793CDA73FULL },
+    { 0xF3A20279ED56D48AULL, 0x6B43527578C1110FULL },
+    { 0x9845418C345644D6ULL, 0x830A13896B78AAA9ULL },
+    { 0xBE5691EF416BD60CULL, 0x23CC986BC656D553ULL },
+    { 0xEDEC366B11C6CB8FULL, 0x2CBFBE86B7EC8AA8ULL },
+    { 0x94B3A202EB1C3F39ULL, 0x7BF7D71432F3D6A9ULL },
+    { 0xB9E08A83A5E34F07ULL, 0xDAF5CCD93FB0CC53ULL },
+    { 0xE858AD248F5C22C9ULL, 0xD1B3400F8F9CFF68ULL },
+    { 0x91376C36D99995BEULL, 0x23100809B9C21FA1ULL },
+    { 0xB58547448FFFFB2DULL, 0xABD40A0C2832A78AULL },
+    { 0xE2E69915B3FFF9F9ULL, 0x16C90C8F323F516CULL },
+    { 0x8DD01FAD907FFC3BULL, 0xAE3DA7D97F6792E3ULL },
+    { 0xB1442798F49FFB4AULL, 0x99CD11CFDF41779CULL },
+    { 0xDD95317F31C7FA1DULL, 0x40405643D711D583ULL },
+    { 0x8A7D3EEF7F1CFC52ULL, 0x482835EA666B2572ULL },
+    { 0xAD1C8EAB5EE43B66ULL, 0xDA3243650005EECFULL },
+    { 0xD863B256369D4A40ULL, 0x90BED43E40076A82ULL },
+    { 0x873E4F75E2224E68ULL, 0x5A7744A6E804A291ULL },
+    { 0xA90DE3535AAAE202ULL, 0x711515D0A205CB36ULL },
+    { 0xD3515C2831559A83ULL, 0x0D5A5B44CA873E03ULL },
+    { 0x8412D9991ED58091ULL, 0xE858790AFE9486C2ULL },
+    { 0xA5178FFF668AE0B6ULL, 0x626E974DBE39A872ULL },
+    { 0xCE5D73FF402D98E3ULL, 0xFB0A3D212DC8128FULL },
+    { 0x80FA687F881C7F8EULL, 0x7CE66634BC9D0B99ULL },
+    { 0xA139029F6A239F72ULL, 0x1C1FFFC1EBC44E80ULL },
+    { 0xC987434744AC874EULL, 0xA327FFB266B56220ULL },
+    { 0xFBE9141915D7A922ULL, 0x4BF1FF9F0062BAA8ULL },
+    { 0x9D71AC8FADA6C9B5ULL, 0x6F773FC3603DB4A9ULL },
+    { 0xC4CE17B399107C22ULL, 0xCB550FB4384D21D3ULL },
+    { 0xF6019DA07F549B2BULL, 0x7E2A53A146606A48ULL },
+    { 0x99C102844F94E0FBULL, 0x2EDA7444CBFC426DULL },
+    { 0xC0314325637A1939ULL, 0xFA911155FEFB5308ULL },
+    { 0xF03D93EEBC589F88ULL, 0x793555AB7EBA27CAULL },
+    { 0x96267C7535B763B5ULL, 0x4BC1558B2F3458DEULL },
+    { 0xBBB01B9283253CA2ULL, 0x9EB1AAEDFB016F16ULL },
+    { 0xEA9C227723EE8BCBULL, 0x465E15A979C1CADCULL },
+    { 0x92A1958A7675175FULL, 0x0BFACD89EC191EC9ULL },
+    { 0xB749FAED14125D36ULL, 0xCEF980EC671F667BULL },
+    { 0xE51C79A85916F484ULL, 0x82B7E12780E7401AULL },
+    { 0x8F31CC0937AE58D2ULL, 0xD1B2ECB8B0908810ULL },
+    { 0xB2FE3F0B8599EF07ULL, 0x861FA7E6DCB4AA15ULL },
+    { 0xDFBDCECE67006AC9ULL, 0x67A791E093E1D49AULL },
+    { 0x8BD6A141006042BDULL, 0xE0C8BB2C5C6D24E0ULL },
+    { 0xAECC49914078536DULL, 0x58FAE9F773886E18ULL },
+    { 0xDA7F5BF590966848ULL, 0xAF39A475506A899EULL },
+    { 0x888F99797A5E012DULL, 0x6D8406C952429603ULL },
+    { 0xAAB37FD7D8F58178ULL, 0xC8E5087BA6D33B83ULL },
+    { 0xD5605FCDCF32E1D6ULL, 0xFB1E4A9A90880A64ULL },
+    { 0x855C3BE0A17FCD26ULL, 0x5CF2EEA09A55067FULL },
+    { 0xA6B34AD8C9DFC06FULL, 0xF42FAA48C0EA481EULL },
+    { 0xD0601D8EFC57B08BULL, 0xF13B94DAF124DA26ULL },
+    { 0x823C12795DB6CE57ULL, 0x76C53D08D6B70858ULL },
+    { 0xA2CB1717B52481EDULL, 0x54768C4B0C64CA6EULL },
+    { 0xCB7DDCDDA26DA268ULL, 0xA9942F5DCF7DFD09ULL },
+    { 0xFE5D54150B090B02ULL, 0xD3F93B35435D7C4CULL },
+    { 0x9EFA548D26E5A6E1ULL, 0xC47BC5014A1A6DAFULL },
+    { 0xC6B8E9B0709F109AULL, 0x359AB6419CA1091BULL },
+    { 0xF867241C8CC6D4C0ULL, 0xC30163D203C94B62ULL },
+    { 0x9B407691D7FC44F8ULL, 0x79E0DE63425DCF1DULL },
+    { 0xC21094364DFB5636ULL, 0x985915FC12F542E4ULL },
+    { 0xF294B943E17A2BC4ULL, 0x3E6F5B7B17B2939DULL },
+    { 0x979CF3CA6CEC5B5AULL, 0xA705992CEECF9C42ULL },
+    { 0xBD8430BD08277231ULL, 0x50C6FF782A838353ULL },
+    { 0xECE53CEC4A314EBDULL, 0xA4F8BF5635246428ULL },
+    { 0x940F4613AE5ED136ULL, 0x871B7795E136BE99ULL },
+    { 0xB913179899F68584ULL, 0x28E2557B59846E3FULL },
+    { 0xE757DD7EC07426E5ULL, 0x331AEADA2FE589CFULL },
+    { 0x9096EA6F3848984FULL, 0x3FF0D2C85DEF7621ULL },
+    { 0xB4BCA50B065ABE63ULL, 0x0FED077A756B53A9ULL },
+    { 0xE1EBCE4DC7F16DFBULL, 0xD3E8495912C62894ULL },
+    { 0x8D3360F09CF6E4BDULL, 0x64712DD7ABBBD95CULL },
+    { 0xB080392CC4349DECULL, 0xBD8D794D96AACFB3ULL },
+    { 0xDCA04777F541C567ULL, 0xECF0D7A0FC5583A0ULL },
+    { 0x89E42CAAF9491B60ULL, 0xF41686C49DB57244ULL },
+    { 0xAC5D37D5B79B6239ULL, 0x311C2875C522CED5ULL },
+    { 0xD77485CB25823AC7ULL, 0x7D633293366B828BULL },
+    { 0x86A8D39EF77164BCULL, 0xAE5DFF9C02033197ULL },
+    { 0xA8530886B54DBDEBULL, 0xD9F57F830283FDFCULL },
+    { 0xD267CAA862A12D66ULL, 0xD072DF63C324FD7BULL },
+    { 0x8380DEA93DA4BC60ULL, 0x4247CB9E59F71E6DULL },
+    { 0xA46116538D0DEB78ULL, 0x52D9BE85F074E608ULL },
+    { 0xCD795BE870516656ULL, 0x67902E276C921F8BULL },
+    { 0x806BD9714632DFF6ULL, 0x00BA1CD8A3DB53B6ULL },
+    { 0xA086CFCD97BF97F3ULL, 0x80E8A40ECCD228A4ULL },
+    { 0xC8A883C0FDAF7DF0ULL, 0x6122CD128006B2CDULL },
+    { 0xFAD2A4B13D1B5D6CULL, 0x796B805720085F81ULL },
+    { 0x9CC3A6EEC6311A63ULL, 0xCBE3303674053BB0ULL },
+    { 0xC3F490AA77BD60FCULL, 0xBEDBFC4411068A9CULL },
+    { 0xF4F1B4D515ACB93BULL, 0xEE92FB5515482D44ULL },
+    { 0x991711052D8BF3C5ULL, 0x751BDD152D4D1C4AULL },
+    { 0xBF5CD54678EEF0B6ULL, 0xD262D45A78A0635DULL },
+    { 0xEF340A98172AACE4ULL, 0x86FB897116C87C34ULL },
+    { 0x9580869F0E7AAC0EULL, 0xD45D35E6AE3D4DA0ULL },
+    { 0xBAE0A846D2195712ULL, 0x8974836059CCA109ULL },
+    { 0xE998D258869FACD7ULL, 0x2BD1A438703FC94BULL },
+    { 0x91FF83775423CC06ULL, 0x7B6306A34627DDCFULL },
+    { 0xB67F6455292CBF08ULL, 0x1A3BC84C17B1D542ULL },
+    { 0xE41F3D6A7377EECAULL, 0x20CABA5F1D9E4A93ULL },
+    { 0x8E938662882AF53EULL, 0x547EB47B7282EE9CULL },
+    { 0xB23867FB2A35B28DULL, 0xE99E619A4F23AA43ULL },
+    { 0xDEC681F9F4C31F31ULL, 0x6405FA00E2EC94D4ULL },
+    { 0x8B3C113C38F9F37EULL, 0xDE83BC408DD3DD04ULL },
+    { 0xAE0B158B4738705EULL, 0x9624AB50B148D445ULL },
+    { 0xD98DDAEE19068C76ULL, 0x3BADD624DD9B0957ULL },
+    { 0x87F8A8D4CFA417C9ULL, 0xE54CA5D70A80E5D6ULL },
+    { 0xA9F6D30A038D1DBCULL, 0x5E9FCF4CCD211F4CULL },
+    { 0xD47487CC8470652BULL, 0x7647C3200069671FULL },
+    { 0x84C8D4DFD2C63F3BULL, 0x29ECD9F40041E073ULL },
+    { 0xA5FB0A17C777CF09ULL, 0xF468107100525890ULL },
+    { 0xCF79CC9DB955C2CCULL, 0x7182148D4066EEB4ULL },
+    { 0x81AC1FE293D599BFULL, 0xC6F14CD848405530ULL },
+    { 0xA21727DB38CB002FULL, 0xB8ADA00E5A506A7CULL },
+    { 0xCA9CF1D206FDC03BULL, 0xA6D90811F0E4851CULL },
+    { 0xFD442E4688BD304AULL, 0x908F4A166D1DA663ULL },
+    { 0x9E4A9CEC15763E2EULL, 0x9A598E4E043287FEULL },
+    { 0xC5DD44271AD3CDBAULL, 0x40EFF1E1853F29FDULL },
+    { 0xF7549530E188C128ULL, 0xD12BEE59E68EF47CULL },
+    { 0x9A94DD3E8CF578B9ULL, 0x82BB74F8301958CEULL },
+    { 0xC13A148E3032D6E7ULL, 0xE36A52363C1FAF01ULL },
+    { 0xF18899B1BC3F8CA1ULL, 0xDC44E6C3CB279AC1ULL },
+    { 0x96F5600F15A7B7E5ULL, 0x29AB103A5EF8C0B9ULL },
+    { 0xBCB2B812DB11A5DEULL, 0x7415D448F6B6F0E7ULL },
+    { 0xEBDF661791D60F56ULL, 0x111B495B3464AD21ULL },
+    { 0x936B9FCEBB25C995ULL, 0xCAB10DD900BEEC34ULL },
+    { 0xB84687C269EF3BFBULL, 0x3D5D514F40EEA742ULL },
+    { 0xE65829B3046B0AFAULL, 0x0CB4A5A3112A5112ULL },
+    { 0x8FF71A0FE2C2E6DCULL, 0x47F0E785EABA72ABULL },
+    { 0xB3F4E093DB73A093ULL, 0x59ED216765690F56ULL },
+    { 0xE0F218B8D25088B8ULL, 0x306869C13EC3532CULL },
+    { 0x8C974F7383725573ULL, 0x1E414218C73A13FBULL },
+    { 0xAFBD2350644EEACFULL, 0xE5D1929EF90898FAULL },
+    { 0xDBAC6C247D62A583ULL, 0xDF45F746B74ABF39ULL },
+    { 0x894BC396CE5DA772ULL, 0x6B8BBA8C328EB783ULL },
+    { 0xAB9EB47C81F5114FULL, 0x066EA92F3F326564ULL },
+    { 0xD686619BA27255A2ULL, 0xC80A537B0EFEFEBDULL },
+    { 0x8613FD0145877585ULL, 0xBD06742CE95F5F36ULL },
+    { 0xA798FC4196E952E7ULL, 0x2C48113823B73704ULL },
+    { 0xD17F3B51FCA3A7A0ULL, 0xF75A15862CA504C5ULL },
+    { 0x82EF85133DE648C4ULL, 0x9A984D73DBE722FBULL },
+    { 0xA3AB66580D5FDAF5ULL, 0xC13E60D0D2E0EBBAULL },
+    { 0xCC963FEE10B7D1B3ULL, 0x318DF905079926A8ULL },
+    { 0xFFBBCFE994E5C61FULL, 0xFDF17746497F7052ULL },
+    { 0x9FD561F1FD0F9BD3ULL, 0xFEB6EA8BEDEFA633ULL },
+    { 0xC7CABA6E7C5382C8ULL, 0xFE64A52EE96B8FC0ULL },
+    { 0xF9BD690A1B68637BULL, 0x3DFDCE7AA3C673B0ULL },
+    { 0x9C1661A651213E2DULL, 0x06BEA10CA65C084EULL },
+    { 0xC31BFA0FE5698DB8ULL, 0x486E494FCFF30A62ULL },
+    { 0xF3E2F893DEC3F126ULL, 0x5A89DBA3C3EFCCFAULL },
+    { 0x986DDB5C6B3A76B7ULL, 0xF89629465A75E01CULL },
+    { 0xBE89523386091465ULL, 0xF6BBB397F1135823ULL },
+    { 0xEE2BA6C0678B597FULL, 0x746AA07DED582E2CULL },
+    { 0x94DB483840B717EFULL, 0xA8C2A44EB4571CDCULL },
+    { 0xBA121A4650E4DDEBULL, 0x92F34D62616CE413ULL },
+    { 0xE896A0D7E51E1566ULL, 0x77B020BAF9C81D17ULL },
+    { 0x915E2486EF32CD60ULL, 0x0ACE1474DC1D122EULL },
+    { 0xB5B5ADA8AAFF80B8ULL, 0x0D819992132456BAULL },
+    { 0xE3231912D5BF60E6ULL, 0x10E1FFF697ED6C69ULL },
+    { 0x8DF5EFABC5979C8FULL, 0xCA8D3FFA1EF463C1ULL },
+    { 0xB1736B96B6FD83B3ULL, 0xBD308FF8A6B17CB2ULL },
+    { 0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDEULL },
+    { 0x8AA22C0DBEF60EE4ULL, 0x6BCDF07A423AA96BULL },
+    { 0xAD4AB7112EB3929DULL, 0x86C16C98D2C953C6ULL },
+    { 0xD89D64D57A607744ULL, 0xE871C7BF077BA8B7ULL },
+    { 0x87625F056C7C4A8BULL, 0x11471CD764AD4972ULL },
+    { 0xA93AF6C6C79B5D2DULL, 0xD598E40D3DD89BCFULL },
+    { 0xD389B47879823479ULL, 0x4AFF1D108D4EC2C3ULL },
+    { 0x843610CB4BF160CBULL, 0xCEDF722A585139BAULL },
+    { 0xA54394FE1EEDB8FEULL, 0xC2974EB4EE658828ULL },
+    { 0xCE947A3DA6A9273EULL, 0x733D226229FEEA32ULL },
+    { 0x811CCC668829B887ULL, 0x0806357D5A3F525FULL },
+    { 0xA163FF802A3426A8ULL, 0xCA07C2DCB0CF26F7ULL },
+    { 0xC9BCFF6034C13052ULL, 0xFC89B393DD02F0B5ULL },
+    { 0xFC2C3F3841F17C67ULL, 0xBBAC2078D443ACE2ULL },
+    { 0x9D9BA7832936EDC0ULL, 0xD54B944B84AA4C0DULL },
+    { 0xC5029163F384A931ULL, 0x0A9E795E65D4DF11ULL },
+    { 0xF64335BCF065D37DULL, 0x4D4617B5FF4A16D5ULL },
+    { 0x99EA0196163FA42EULL, 0x504BCED1BF8E4E45ULL },
+    { 0xC06481FB9BCF8D39ULL, 0xE45EC2862F71E1D6ULL },
+    { 0xF07DA27A82C37088ULL, 0x5D767327BB4E5A4CULL },
+    { 0x964E858C91BA2655ULL, 0x3A6A07F8D510F86FULL },
+    { 0xBBE226EFB628AFEAULL, 0x890489F70A55368BULL },
+    { 0xEADAB0ABA3B2DBE5ULL, 0x2B45AC74CCEA842EULL },
+    { 0x92C8AE6B464FC96FULL, 0x3B0B8BC90012929DULL },
+    { 0xB77ADA0617E3BBCBULL, 0x09CE6EBB40173744ULL },
+    { 0xE55990879DDCAABDULL, 0xCC420A6A101D0515ULL },
+    { 0x8F57FA54C2A9EAB6ULL, 0x9FA946824A12232DULL },
+    { 0xB32DF8E9F3546564ULL, 0x47939822DC96ABF9ULL },
+    { 0xDFF9772470297EBDULL, 0x59787E2B93BC56F7ULL },
+    { 0x8BFBEA76C619EF36ULL, 0x57EB4EDB3C55B65AULL },
+    { 0xAEFAE51477A06B03ULL, 0xEDE622920B6B23F1ULL },
+    { 0xDAB99E59958885C4ULL, 0xE95FAB368E45ECEDULL },
+    { 0x88B402F7FD75539BULL, 0x11DBCB0218EBB414ULL },
+    { 0xAAE103B5FCD2A881ULL, 0xD652BDC29F26A119ULL },
+    { 0xD59944A37C0752A2ULL, 0x4BE76D3346F0495FULL },
+    { 0x857FCAE62D8493A5ULL, 0x6F70A4400C562DDBULL },
+    { 0xA6DFBD9FB8E5B88EULL, 0xCB4CCD500F6BB952ULL },
+    { 0xD097AD07A71F26B2ULL, 0x7E2000A41346A7A7ULL },
+    { 0x825ECC24C873782FULL, 0x8ED400668C0C28C8ULL },
+    { 0xA2F67F2DFA90563BULL, 0x728900802F0F32FAULL },
+    { 0xCBB41EF979346BCAULL, 0x4F2B40A03AD2FFB9ULL },
+    { 0xFEA126B7D78186BCULL, 0xE2F610C84987BFA8ULL },
+    { 0x9F24B832E6B0F436ULL, 0x0DD9CA7D2DF4D7C9ULL },
+    { 0xC6EDE63FA05D3143ULL, 0x91503D1C79720DBBULL },
+    { 0xF8A95FCF88747D94ULL, 0x75A44C6397CE912AULL },
+    { 0x9B69DBE1B548CE7CULL, 0xC986AFBE3EE11ABAULL },
+    { 0xC24452DA229B021BULL, 0xFBE85BADCE996168ULL },
+    { 0xF2D56790AB41C2A2ULL, 0xFAE27299423FB9C3ULL },
+    { 0x97C560BA6B0919A5ULL, 0xDCCD879FC967D41AULL },
+    { 0xBDB6B8E905CB600FULL, 0x5400E987BBC1C920ULL },
+    { 0xED246723473E3813ULL, 0x290123E9AAB23B68ULL },
+    { 0x9436C0760C86E30BULL, 0xF9A0B6720AAF6521ULL },
+    { 0xB94470938FA89BCEULL, 0xF808E40E8D5B3E69ULL },
+    { 0xE7958CB87392C2C2ULL, 0xB60B1D1230B20E04ULL },
+    { 0x90BD77F3483BB9B9ULL, 0xB1C6F22B5E6F48C2ULL },
+    { 0xB4ECD5F01A4AA828ULL, 0x1E38AEB6360B1AF3ULL },
+    { 0xE2280B6C20DD5232ULL, 0x25C6DA63C38DE1B0ULL },
+    { 0x8D590723948A535FULL, 0x579C487E5A38AD0EULL },
+    { 0xB0AF48EC79ACE837ULL, 0x2D835A9DF0C6D851ULL },
+    { 0xDCDB1B2798182244ULL, 0xF8E431456CF88E65ULL },
+    { 0x8A08F0F8BF0F156BULL, 0x1B8E9ECB641B58FFULL },
+    { 0xAC8B2D36EED2DAC5ULL, 0xE272467E3D222F3FULL },
+    { 0xD7ADF884AA879177ULL, 0x5B0ED81DCC6ABB0FULL },
+    { 0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL },
+    { 0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL },
+    { 0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL },
+    { 0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL },
+    { 0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL },
+    { 0xCDB02555653131B6ULL, 0x3792F412CB06794DULL },
+    { 0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL },
+    { 0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL },
+    { 0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL },
+    { 0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL },
+    { 0x9CED737BB6C4183DULL, 0x55464DD69685606BULL },
+    { 0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL },
+    { 0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL },
+    { 0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL },
+    { 0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL },
+    { 0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL },
+    { 0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL },
+    { 0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL },
+    { 0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL },
+    { 0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL },
+    { 0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL },
+    { 0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL },
+    { 0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL },
+    { 0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL },
+    { 0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL },
+    { 0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL },
+    { 0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL },
+    { 0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL },
+    { 0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL },
+    { 0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL },
+    { 0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL },
+    { 0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL },
+    { 0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL },
+    { 0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL },
+    { 0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL },
+    { 0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL },
+    { 0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL },
+    { 0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL },
+    { 0x9E74D1B791E07E48ULL, 0x775EA264CF55347DULL },
+    { 0xC612062576589DDAULL, 0x95364AFE032A819DULL },
+    { 0xF79687AED3EEC551ULL, 0x3A83DDBD83F52204ULL },
+    { 0x9ABE14CD44753B52ULL, 0xC4926A9672793542ULL },
+    { 0xC16D9A0095928A27ULL, 0x75B7053C0F178293ULL },
+    { 0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6338ULL },
+    { 0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E03ULL },
+    { 0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF584ULL },
+    { 0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E5ULL },
+    { 0x9392EE8E921D5D07ULL, 0x3AFF322E62439FCFULL },
+    { 0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C2ULL },
+    { 0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B3ULL },
+    { 0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A10ULL },
+    { 0xB424DC35095CD80FULL, 0x538484C19EF38C94ULL },
+    { 0xE12E13424BB40E13ULL, 0x2865A5F206B06FB9ULL },
+    { 0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D3ULL },
+    { 0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D748ULL },
+    { 0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1BULL },
+    { 0x89705F4136B4A597ULL, 0x31680A88F8953030ULL },
+    { 0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3DULL },
+    { 0xD6BF94D5E57A42BCULL, 0x3D32907604691B4CULL },
+    { 0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B10FULL },
+    { 0xA7C5AC471B478423ULL, 0x0FCF80DC33721D53ULL },
+    { 0xD1B71758E219652BULL, 0xD3C36113404EA4A8ULL },
+    { 0x83126E978D4FDF3BULL, 0x645A1CAC083126E9ULL },
+    { 0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A3ULL },
+    { 0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCCULL },
+    { 0x8000000000000000ULL, 0x0000000000000000ULL },
+    { 0xA000000000000000ULL, 0x0000000000000000ULL },
+    { 0xC800000000000000ULL, 0x0000000000000000ULL },
+    { 0xFA00000000000000ULL, 0x0000000000000000ULL },
+    { 0x9C40000000000000ULL, 0x0000000000000000ULL },
+    { 0xC350000000000000ULL, 0x0000000000000000ULL },
+    { 0xF424000000000000ULL, 0x0000000000000000ULL },
+    { 0x9896800000000000ULL, 0x0000000000000000ULL },
+    { 0xBEBC200000000000ULL, 0x0000000000000000ULL },
+    { 0xEE6B280000000000ULL, 0x0000000000000000ULL },
+    { 0x9502F90000000000ULL, 0x0000000000000000ULL },
+    { 0xBA43B74000000000ULL, 0x0000000000000000ULL },
+    { 0xE8D4A51000000000ULL, 0x0000000000000000ULL },
+    { 0x9184E72A00000000ULL, 0x0000000000000000ULL },
+    { 0xB5E620F480000000ULL, 0x0000000000000000ULL },
+    { 0xE35FA931A0000000ULL, 0x0000000000000000ULL },
+    { 0x8E1BC9BF04000000ULL, 0x0000000000000000ULL },
+    { 0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL },
+    { 0xDE0B6B3A76400000ULL, 0x0000000000000000ULL },
+    { 0x8AC7230489E80000ULL, 0x0000000000000000ULL },
+    { 0xAD78EBC5AC620000ULL, 0x0000000000000000ULL },
+    { 0xD8D726B7177A8000ULL, 0x0000000000000000ULL },
+    { 0x878678326EAC9000ULL, 0x0000000000000000ULL },
+    { 0xA968163F0A57B400ULL, 0x0000000000000000ULL },
+    { 0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL },
+    { 0x84595161401484A0ULL, 0x0000000000000000ULL },
+    { 0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL },
+    { 0xCECB8F27F4200F3AULL, 0x0000000000000000ULL },
+    { 0x813F3978F8940984ULL, 0x4000000000000000ULL },
+    { 0xA18F07D736B90BE5ULL, 0x5000000000000000ULL },
+    { 0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL },
+    { 0xFC6F7C4045812296ULL, 0x4D00000000000000ULL },
+    { 0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL },
+    { 0xC5371912364CE305ULL, 0x6C28000000000000ULL },
+    { 0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL },
+    { 0x9A130B963A6C115CULL, 0x3C7F400000000000ULL },
+    { 0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL },
+    { 0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL },
+    { 0x96769950B50D88F4ULL, 0x1314448000000000ULL },
+    { 0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL },
+    { 0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL },
+    { 0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL },
+    { 0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL },
+    { 0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL },
+    { 0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL },
+    { 0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL },
+    { 0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL },
+    { 0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL },
+    { 0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL },
+    { 0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL },
+    { 0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL },
+    { 0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL },
+    { 0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL },
+    { 0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL },
+    { 0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL },
+    { 0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL },
+    { 0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL },
+    { 0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL },
+    { 0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL },
+    { 0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL },
+    { 0x9F4F2726179A2245ULL, 0x01D762422C946590ULL },
+    { 0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL },
+    { 0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL },
+    { 0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL },
+    { 0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL },
+    { 0xF316271C7FC3908AULL, 0x8BEF464E3945EF7AULL },
+    { 0x97EDD871CFDA3A56ULL, 0x97758BF0E3CBB5ACULL },
+    { 0xBDE94E8E43D0C8ECULL, 0x3D52EEED1CBEA317ULL },
+    { 0xED63A231D4C4FB27ULL, 0x4CA7AAA863EE4BDDULL },
+    { 0x945E455F24FB1CF8ULL, 0x8FE8CAA93E74EF6AULL },
+    { 0xB975D6B6EE39E436ULL, 0xB3E2FD538E122B44ULL },
+    { 0xE7D34C64A9C85D44ULL, 0x60DBBCA87196B616ULL },
+    { 0x90E40FBEEA1D3A4AULL, 0xBC8955E946FE31CDULL },
+    { 0xB51D13AEA4A488DDULL, 0x6BABAB6398BDBE41ULL },
+    { 0xE264589A4DCDAB14ULL, 0xC696963C7EED2DD1ULL },
+    { 0x8D7EB76070A08AECULL, 0xFC1E1DE5CF543CA2ULL },
+    { 0xB0DE65388CC8ADA8ULL, 0x3B25A55F43294BCBULL },
+    { 0xDD15FE86AFFAD912ULL, 0x49EF0EB713F39EBEULL },
+    { 0x8A2DBF142DFCC7ABULL, 0x6E3569326C784337ULL },
+    { 0xACB92ED9397BF996ULL, 0x49C2C37F07965404ULL },
+    { 0xD7E77A8F87DAF7FBULL, 0xDC33745EC97BE906ULL },
+    { 0x86F0AC99B4E8DAFDULL, 0x69A028BB3DED71A3ULL },
+    { 0xA8ACD7C0222311BCULL, 0xC40832EA0D68CE0CULL },
+    { 0xD2D80DB02AABD62BULL, 0xF50A3FA490C30190ULL },
+    { 0x83C7088E1AAB65DBULL, 0x792667C6DA79E0FAULL },
+    { 0xA4B8CAB1A1563F52ULL, 0x577001B891185938ULL },
+    { 0xCDE6FD5E09ABCF26ULL, 0xED4C0226B55E6F86ULL },
+    { 0x80B05E5AC60B6178ULL, 0x544F8158315B05B4ULL },
+    { 0xA0DC75F1778E39D6ULL, 0x696361AE3DB1C721ULL },
+    { 0xC913936DD571C84CULL, 0x03BC3A19CD1E38E9ULL },
+    { 0xFB5878494ACE3A5FULL, 0x04AB48A04065C723ULL },
+    { 0x9D174B2DCEC0E47BULL, 0x62EB0D64283F9C76ULL },
+    { 0xC45D1DF942711D9AULL, 0x3BA5D0BD324F8394ULL },
+    { 0xF5746577930D6500ULL, 0xCA8F44EC7EE36479ULL },
+    { 0x9968BF6ABBE85F20ULL, 0x7E998B13CF4E1ECBULL },
+    { 0xBFC2EF456AE276E8ULL, 0x9E3FEDD8C321A67EULL },
+    { 0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101EULL },
+    { 0x95D04AEE3B80ECE5ULL, 0xBBA1F1D158724A12ULL },
+    { 0xBB445DA9CA61281FULL, 0x2A8A6E45AE8EDC97ULL },
+    { 0xEA1575143CF97226ULL, 0xF52D09D71A3293BDULL },
+    { 0x924D692CA61BE758ULL, 0x593C2626705F9C56ULL },
+    { 0xB6E0C377CFA2E12EULL, 0x6F8B2FB00C77836CULL },
+    { 0xE498F455C38B997AULL, 0x0B6DFB9C0F956447ULL },
+    { 0x8EDF98B59A373FECULL, 0x4724BD4189BD5EACULL },
+    { 0xB2977EE300C50FE7ULL, 0x58EDEC91EC2CB657ULL },
+    { 0xDF3D5E9BC0F653E1ULL, 0x2F2967B66737E3EDULL },
+    { 0x8B865B215899F46CULL, 0xBD79E0D20082EE74ULL },
+    { 0xAE67F1E9AEC07187ULL, 0xECD8590680A3AA11ULL },
+    { 0xDA01EE641A708DE9ULL, 0xE80E6F4820CC9495ULL },
+    { 0x884134FE908658B2ULL, 0x3109058D147FDCDDULL },
+    { 0xAA51823E34A7EEDEULL, 0xBD4B46F0599FD415ULL },
+    { 0xD4E5E2CDC1D1EA96ULL, 0x6C9E18AC7007C91AULL },
+    { 0x850FADC09923329EULL, 0x03E2CF6BC604DDB0ULL },
+    { 0xA6539930BF6BFF45ULL, 0x84DB8346B786151CULL },
+    { 0xCFE87F7CEF46FF16ULL, 0xE612641865679A63ULL },
+    { 0x81F14FAE158C5F6EULL, 0x4FCB7E8F3F60C07EULL },
+    { 0xA26DA3999AEF7749ULL, 0xE3BE5E330F38F09DULL },
+    { 0xCB090C8001AB551CULL, 0x5CADF5BFD3072CC5ULL },
+    { 0xFDCB4FA002162A63ULL, 0x73D9732FC7C8F7F6ULL },
+    { 0x9E9F11C4014DDA7EULL, 0x2867E7FDDCDD9AFAULL },
+    { 0xC646D63501A1511DULL, 0xB281E1FD541501B8ULL },
+    { 0xF7D88BC24209A565ULL, 0x1F225A7CA91A4226ULL },
+    { 0x9AE757596946075FULL, 0x3375788DE9B06958ULL },
+    { 0xC1A12D2FC3978937ULL, 0x0052D6B1641C83AEULL },
+    { 0xF209787BB47D6B84ULL, 0xC0678C5DBD23A49AULL },
+    { 0x9745EB4D50CE6332ULL, 0xF840B7BA963646E0ULL },
+    { 0xBD176620A501FBFFULL, 0xB650E5A93BC3D898ULL },
+    { 0xEC5D3FA8CE427AFFULL, 0xA3E51F138AB4CEBEULL },
+    { 0x93BA47C980E98CDFULL, 0xC66F336C36B10137ULL },
+    { 0xB8A8D9BBE123F017ULL, 0xB80B0047445D4184ULL },
+    { 0xE6D3102AD96CEC1DULL, 0xA60DC059157491E5ULL },
+    { 0x9043EA1AC7E41392ULL, 0x87C89837AD68DB2FULL },
+    { 0xB454E4A179DD1877ULL, 0x29BABE4598C311FBULL },
+    { 0xE16A1DC9D8545E94ULL, 0xF4296DD6FEF3D67AULL },
+    { 0x8CE2529E2734BB1DULL, 0x1899E4A65F58660CULL },
+    { 0xB01AE745B101E9E4ULL, 0x5EC05DCFF72E7F8FULL },
+    { 0xDC21A1171D42645DULL, 0x76707543F4FA1F73ULL },
+    { 0x899504AE72497EBAULL, 0x6A06494A791C53A8ULL },
+    { 0xABFA45DA0EDBDE69ULL, 0x0487DB9D17636892ULL },
+    { 0xD6F8D7509292D603ULL, 0x45A9D2845D3C42B6ULL },
+    { 0x865B86925B9BC5C2ULL, 0x0B8A2392BA45A9B2ULL },
+    { 0xA7F26836F282B732ULL, 0x8E6CAC7768D7141EULL },
+    { 0xD1EF0244AF2364FFULL, 0x3207D795430CD926ULL },
+    { 0x8335616AED761F1FULL, 0x7F44E6BD49E807B8ULL },
+    { 0xA402B9C5A8D3A6E7ULL, 0x5F16206C9C6209A6ULL },
+    { 0xCD036837130890A1ULL, 0x36DBA887C37A8C0FULL },
+    { 0x802221226BE55A64ULL, 0xC2494954DA2C9789ULL },
+    { 0xA02AA96B06DEB0FDULL, 0xF2DB9BAA10B7BD6CULL },
+    { 0xC83553C5C8965D3DULL, 0x6F92829494E5ACC7ULL },
+    { 0xFA42A8B73ABBF48CULL, 0xCB772339BA1F17F9ULL },
+    { 0x9C69A97284B578D7ULL, 0xFF2A760414536EFBULL },
+    { 0xC38413CF25E2D70DULL, 0xFEF5138519684ABAULL },
+    { 0xF46518C2EF5B8CD1ULL, 0x7EB258665FC25D69ULL },
+    { 0x98BF2F79D5993802ULL, 0xEF2F773FFBD97A61ULL },
+    { 0xBEEEFB584AFF8603ULL, 0xAAFB550FFACFD8FAULL },
+    { 0xEEAABA2E5DBF6784ULL, 0x95BA2A53F983CF38ULL },
+    { 0x952AB45CFA97A0B2ULL, 0xDD945A747BF26183ULL },
+    { 0xBA756174393D88DFULL, 0x94F971119AEEF9E4ULL },
+    { 0xE912B9D1478CEB17ULL, 0x7A37CD5601AAB85DULL },
+    { 0x91ABB422CCB812EEULL, 0xAC62E055C10AB33AULL },
+    { 0xB616A12B7FE617AAULL, 0x577B986B314D6009ULL },
+    { 0xE39C49765FDF9D94ULL, 0xED5A7E85FDA0B80BULL },
+    { 0x8E41ADE9FBEBC27DULL, 0x14588F13BE847307ULL },
+    { 0xB1D219647AE6B31CULL, 0x596EB2D8AE258FC8ULL },
+    { 0xDE469FBD99A05FE3ULL, 0x6FCA5F8ED9AEF3BBULL },
+    { 0x8AEC23D680043BEEULL, 0x25DE7BB9480D5854ULL },
+    { 0xADA72CCC20054AE9ULL, 0xAF561AA79A10AE6AULL },
+    { 0xD910F7FF28069DA4ULL, 0x1B2BA1518094DA04ULL },
+    { 0x87AA9AFF79042286ULL, 0x90FB44D2F05D0842ULL },
+    { 0xA99541BF57452B28ULL, 0x353A1607AC744A53ULL },
+    { 0xD3FA922F2D1675F2ULL, 0x42889B8997915CE8ULL },
+    { 0x847C9B5D7C2E09B7ULL, 0x69956135FEBADA11ULL },
+    { 0xA59BC234DB398C25ULL, 0x43FAB9837E699095ULL },
+    { 0xCF02B2C21207EF2EULL, 0x94F967E45E03F4BBULL },
+    { 0x8161AFB94B44F57DULL, 0x1D1BE0EEBAC278F5ULL },
+    { 0xA1BA1BA79E1632DCULL, 0x6462D92A69731732ULL },
+    { 0xCA28A291859BBF93ULL, 0x7D7B8F7503CFDCFEULL },
+    { 0xFCB2CB35E702AF78ULL, 0x5CDA735244C3D43EULL },
+    { 0x9DEFBF01B061ADABULL, 0x3A0888136AFA64A7ULL },
+    { 0xC56BAEC21C7A1916ULL, 0x088AAA1845B8FDD0ULL },
+    { 0xF6C69A72A3989F5BULL, 0x8AAD549E57273D45ULL },
+    { 0x9A3C2087A63F6399ULL, 0x36AC54E2F678864BULL },
+    { 0xC0CB28A98FCF3C7FULL, 0x84576A1BB416A7DDULL },
+    { 0xF0FDF2D3F3C30B9FULL, 0x656D44A2A11C51D5ULL },
+    { 0x969EB7C47859E743ULL, 0x9F644AE5A4B1B325ULL },
+    { 0xBC4665B596706114ULL, 0x873D5D9F0DDE1FEEULL },
+    { 0xEB57FF22FC0C7959ULL, 0xA90CB506D155A7EAULL },
+    { 0x9316FF75DD87CBD8ULL, 0x09A7F12442D588F2ULL },
+    { 0xB7DCBF5354E9BECEULL, 0x0C11ED6D538AEB2FULL },
+    { 0xE5D3EF282A242E81ULL, 0x8F1668C8A86DA5FAULL },
+    { 0x8FA475791A569D10ULL, 0xF96E017D694487BCULL },
+    { 0xB38D92D760EC4455ULL, 0x37C981DCC395A9ACULL },
+    { 0xE070F78D3927556AULL, 0x85BBE253F47B1417ULL },
+    { 0x8C469AB843B89562ULL, 0x93956D7478CCEC8EULL },
+    { 0xAF58416654A6BABBULL, 0x387AC8D1970027B2ULL },
+    { 0xDB2E51BFE9D0696AULL, 0x06997B05FCC0319EULL },
+    { 0x88FCF317F22241E2ULL, 0x441FECE3BDF81F03ULL },
+    { 0xAB3C2FDDEEAAD25AULL, 0xD527E81CAD7626C3ULL },
+    { 0xD60B3BD56A5586F1ULL, 0x8A71E223D8D3B074ULL },
+    { 0x85C7056562757456ULL, 0xF6872D5667844E49ULL },
+    { 0xA738C6BEBB12D16CULL, 0xB428F8AC016561DBULL },
+    { 0xD106F86E69D785C7ULL, 0xE13336D701BEBA52ULL },
+    { 0x82A45B450226B39CULL, 0xECC0024661173473ULL },
+    { 0xA34D721642B06084ULL, 0x27F002D7F95D0190ULL },
+    { 0xCC20CE9BD35C78A5ULL, 0x31EC038DF7B441F4ULL },
+    { 0xFF290242C83396CEULL, 0x7E67047175A15271ULL },
+    { 0x9F79A169BD203E41ULL, 0x0F0062C6E984D386ULL },
+    { 0xC75809C42C684DD1ULL, 0x52C07B78A3E60868ULL },
+    { 0xF92E0C3537826145ULL, 0xA7709A56CCDF8A82ULL },
+    { 0x9BBCC7A142B17CCBULL, 0x88A66076400BB691ULL },
+    { 0xC2ABF989935DDBFEULL, 0x6ACFF893D00EA435ULL },
+    { 0xF356F7EBF83552FEULL, 0x0583F6B8C4124D43ULL },
+    { 0x98165AF37B2153DEULL, 0xC3727A337A8B704AULL },
+    { 0xBE1BF1B059E9A8D6ULL, 0x744F18C0592E4C5CULL },
+    { 0xEDA2EE1C7064130CULL, 0x1162DEF06F79DF73ULL },
+    { 0x9485D4D1C63E8BE7ULL, 0x8ADDCB5645AC2BA8ULL },
+    { 0xB9A74A0637CE2EE1ULL, 0x6D953E2BD7173692ULL },
+    { 0xE8111C87C5C1BA99ULL, 0xC8FA8DB6CCDD0437ULL },
+    { 0x910AB1D4DB9914A0ULL, 0x1D9C9892400A22A2ULL },
+    { 0xB54D5E4A127F59C8ULL, 0x2503BEB6D00CAB4BULL },
+    { 0xE2A0B5DC971F303AULL, 0x2E44AE64840FD61DULL },
+    { 0x8DA471A9DE737E24ULL, 0x5CEAECFED289E5D2ULL },
+    { 0xB10D8E1456105DADULL, 0x7425A83E872C5F47ULL },
+    { 0xDD50F1996B947518ULL, 0xD12F124E28F77719ULL },
+    { 0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA6FULL },
+    { 0xACE73CBFDC0BFB7BULL, 0x636CC64D1001550BULL },
+    { 0xD8210BEFD30EFA5AULL, 0x3C47F7E05401AA4EULL },
+    { 0x8714A775E3E95C78ULL, 0x65ACFAEC34810A71ULL },
+    { 0xA8D9D1535CE3B396ULL, 0x7F1839A741A14D0DULL },
+    { 0xD31045A8341CA07CULL, 0x1EDE48111209A050ULL },
+    { 0x83EA2B892091E44DULL, 0x934AED0AAB460432ULL },
+    { 0xA4E4B66B68B65D60ULL, 0xF81DA84D5617853FULL },
+    { 0xCE1DE40642E3F4B9ULL, 0x36251260AB9D668EULL },
+    { 0x80D2AE83E9CE78F3ULL, 0xC1D72B7C6B426019ULL },
+    { 0xA1075A24E4421730ULL, 0xB24CF65B8612F81FULL },
+    { 0xC94930AE1D529CFCULL, 0xDEE033F26797B627ULL },
+    { 0xFB9B7CD9A4A7443CULL, 0x169840EF017DA3B1ULL },
+    { 0x9D412E0806E88AA5ULL, 0x8E1F289560EE864EULL },
+    { 0xC491798A08A2AD4EULL, 0xF1A6F2BAB92A27E2ULL },
+    { 0xF5B5D7EC8ACB58A2ULL, 0xAE10AF696774B1DBULL },
+    { 0x9991A6F3D6BF1765ULL, 0xACCA6DA1E0A8EF29ULL },
+    { 0xBFF610B0CC6EDD3FULL, 0x17FD090A58D32AF3ULL },
+    { 0xEFF394DCFF8A948EULL, 0xDDFC4B4CEF07F5B0ULL },
+    { 0x95F83D0A1FB69CD9ULL, 0x4ABDAF101564F98EULL },
+    { 0xBB764C4CA7A4440FULL, 0x9D6D1AD41ABE37F1ULL },
+    { 0xEA53DF5FD18D5513ULL, 0x84C86189216DC5EDULL },
+    { 0x92746B9BE2F8552CULL, 0x32FD3CF5B4E49BB4ULL },
+    { 0xB7118682DBB66A77ULL, 0x3FBC8C33221DC2A1ULL },
+    { 0xE4D5E82392A40515ULL, 0x0FABAF3FEAA5334AULL },
+    { 0x8F05B1163BA6832DULL, 0x29CB4D87F2A7400EULL },
+    { 0xB2C71D5BCA9023F8ULL, 0x743E20E9EF511012ULL },
+    { 0xDF78E4B2BD342CF6ULL, 0x914DA9246B255416ULL },
+    { 0x8BAB8EEFB6409C1AULL, 0x1AD089B6C2F7548EULL },
+    { 0xAE9672ABA3D0C320ULL, 0xA184AC2473B529B1ULL },
+    { 0xDA3C0F568CC4F3E8ULL, 0xC9E5D72D90A2741EULL },
+    { 0x8865899617FB1871ULL, 0x7E2FA67C7A658892ULL },
+    { 0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB7ULL },
+    { 0xD51EA6FA85785631ULL, 0x552A74227F3EA565ULL },
+    { 0x8533285C936B35DEULL, 0xD53A88958F87275FULL },
+    { 0xA67FF273B8460356ULL, 0x8A892ABAF368F137ULL },
+    { 0xD01FEF10A657842CULL, 0x2D2B7569B0432D85ULL },
+    { 0x8213F56A67F6B29BULL, 0x9C3B29620E29FC73ULL },
+    { 0xA298F2C501F45F42ULL, 0x8349F3BA91B47B8FULL },
+    { 0xCB3F2F7642717713ULL, 0x241C70A936219A73ULL },
+    { 0xFE0EFB53D30DD4D7ULL, 0xED238CD383AA0110ULL },
+    { 0x9EC95D1463E8A506ULL, 0xF4363804324A40AAULL },
+    { 0xC67BB4597CE2CE48ULL, 0xB143C6053EDCD0D5ULL },
+    { 0xF81AA16FDC1B81DAULL, 0xDD94B7868E94050AULL },
+    { 0x9B10A4E5E9913128ULL, 0xCA7CF2B4191C8326ULL },
+    { 0xC1D4CE1F63F57D72ULL, 0xFD1C2F611F63A3F0ULL },
+    { 0xF24A01A73CF2DCCFULL, 0xBC633B39673C8CECULL },
+    { 0x976E41088617CA01ULL, 0xD5BE0503E085D813ULL },
+    { 0xBD49D14AA79DBC82ULL, 0x4B2D8644D8A74E18ULL },
+    { 0xEC9C459D51852BA2ULL, 0xDDF8E7D60ED1219EULL },
+    { 0x93E1AB8252F33B45ULL, 0xCABB90E5C942B503ULL },
+    { 0xB8DA1662E7B00A17ULL, 0x3D6A751F3B936243ULL },
+    { 0xE7109BFBA19C0C9DULL, 0x0CC512670A783AD4ULL },
+    { 0x906A617D450187E2ULL, 0x27FB2B80668B24C5ULL },
+    { 0xB484F9DC9641E9DAULL, 0xB1F9F660802DEDF6ULL },
+    { 0xE1A63853BBD26451ULL, 0x5E7873F8A0396973ULL },
+    { 0x8D07E33455637EB2ULL, 0xDB0B487B6423E1E8ULL },
+    { 0xB049DC016ABC5E5FULL, 0x91CE1A9A3D2CDA62ULL },
+    { 0xDC5C5301C56B75F7ULL, 0x7641A140CC7810FBULL },
+    { 0x89B9B3E11B6329BAULL, 0xA9E904C87FCB0A9DULL },
+    { 0xAC2820D9623BF429ULL, 0x546345FA9FBDCD44ULL },
+    { 0xD732290FBACAF133ULL, 0xA97C177947AD4095ULL },
+    { 0x867F59A9D4BED6C0ULL, 0x49ED8EABCCCC485DULL },
+    { 0xA81F301449EE8C70ULL, 0x5C68F256BFFF5A74ULL },
+    { 0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3111ULL },
+    { 0x83585D8FD9C25DB7ULL, 0xC831FD53C5FF7EABULL },
+    { 0xA42E74F3D032F525ULL, 0xBA3E7CA8B77F5E55ULL },
+    { 0xCD3A1230C43FB26FULL, 0x28CE1BD2E55F35EBULL },
+    { 0x80444B5E7AA7CF85ULL, 0x7980D163CF5B81B3ULL },
+    { 0xA0555E361951C366ULL, 0xD7E105BCC332621FULL },
+    { 0xC86AB5C39FA63440ULL, 0x8DD9472BF3FEFAA7ULL },
+    { 0xFA856334878FC150ULL, 0xB14F98F6F0FEB951ULL },
+    { 0x9C935E00D4B9D8D2ULL, 0x6ED1BF9A569F33D3ULL },
+    { 0xC3B8358109E84F07ULL, 0x0A862F80EC4700C8ULL },
+    { 0xF4A642E14C6262C8ULL, 0xCD27BB612758C0FAULL },
+    { 0x98E7E9CCCFBD7DBDULL, 0x8038D51CB897789CULL },
+    { 0xBF21E44003ACDD2CULL, 0xE0470A63E6BD56C3ULL },
+    { 0xEEEA5D5004981478ULL, 0x1858CCFCE06CAC74ULL },
+    { 0x95527A5202DF0CCBULL, 0x0F37801E0C43EBC8ULL },
+    { 0xBAA718E68396CFFDULL, 0xD30560258F54E6BAULL },
+    { 0xE950DF20247C83FDULL, 0x47C6B82EF32A2069ULL },
+    { 0x91D28B7416CDD27EULL, 0x4CDC331D57FA5441ULL },
+    { 0xB6472E511C81471DULL, 0xE0133FE4ADF8E952ULL },
+    { 0xE3D8F9E563A198E5ULL, 0x58180FDDD97723A6ULL },
+    { 0x8E679C2F5E44FF8FULL, 0x570F09EAA7EA7648ULL }
+};
+
+/** Powers of ten which are exactly representable as double. */
+static const double jfes_exact_powers_of_ten[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/** Arbitrary precision decimal number used by the exact conversion. */
+typedef struct jfes_decimal {
+    unsigned char           digits[JFES_DECIMAL_DIGITS + JFES_DECIMAL_SHIFT_DIGITS]; /**< Digits, most significant first. */
+    jfes_size_t             count;              /**< Digits count. */
+    int                     point;              /**< Decimal point position. */
+    int                     truncated;          /**< Non-zero if there were dropped non-zero digits. */
+} jfes_decimal_t;
+
+/** Helper to reinterpret bits of the double. */
+typedef union jfes_double_bits {
+    double                  value;              /**< Double value. */
+    unsigned long long      bits;               /**< Double bits. */
+} jfes_double_bits_t;
 
 /**
-    Analyzes input string on the subject of whether it is an integer.
+    Builds double from its bits.
 
-    \param[in]      data                Input string.
-    \param[in]      length              Optional. String length. You can pass zero
-                                        if `data` is a null-terminated string.
+    \param[in]      negative            Non-zero if the value is negative.
+    \param[in]      exponent            Biased binary exponent.
+    \param[in]      mantissa            Mantissa without the implicit bit.
 
-    \return         Zero if input string is not an integer. Otherwise anything.
+    \return         Double value.
 */
-static int jfes_is_integer(const char *data, jfes_size_t length) {
-    if (!data) {
-        return 0;
+static double jfes_make_double(int negative, unsigned long long exponent, unsigned long long mantissa) {
+    jfes_double_bits_t result;
+    result.bits = (exponent << 52) | (mantissa & 0x000FFFFFFFFFFFFFULL);
+    if (negative) {
+        result.bits |= 0x8000000000000000ULL;
     }
 
-    if (length == 0) {
-        length = jfes_strlen(data);
-    }
+    return result.value;
+}
 
-    jfes_size_t offset = 0;
-    if (data[0] == '-') {
-        offset = 1;
-    }
+/**
+    Counts leading zero bits.
 
-    int hexadecimal_case = 0;
-    if (length > offset + 2 && data[offset] == '0' && 
-       (data[offset + 1] == 'x' || data[offset + 1] == 'X')) {
-        hexadecimal_case = 1;
-    }
+    \param[in]      value               Non-zero value.
 
-    int is_integer = 1;
+    \return         Count of leading zero bits.
+*/
+static int jfes_count_leading_zeros(unsigned long long value) {
+#if defined(__GNUC__)
+    return __builtin_clzll(value);
+#else
+    int count = 0;
+    while (!(value & 0x8000000000000000ULL)) {
+        value <<= 1;
+        count++;
+    }
+    return count;
+#endif
+}
 
-    for (jfes_size_t i = offset; i < length; i++) {
-        if ((data[i] >= '0' && data[i] <= '9') || (hexadecimal_case &&
-            ((data[i] >= 'A' && data[i] <= 'F') || (data[i] >= 'a' && data[i] <= 'f'))) || 
-            (i == offset + 1 && ((data[i] == 'x') || (data[i] == 'X')) && length > offset + 2)) {
+#if defined(__SIZEOF_INT128__)
+/** 128-bit product of jfes_multiply_64. __extension__ keeps pedantic C99 builds quiet. */
+__extension__ typedef unsigned __int128 jfes_uint128_t;
+#endif
 
-            if (hexadecimal_case && i == offset && data[i] != '0') {
-                is_integer = 0;
-                break;
-            }
-            continue;
-        }
+/**
+    Multiplies two 64-bit values.
 
-        is_integer = 0;
-        break;
-    }
+    \param[in]      a                   First multiplier.
+    \param[in]      b                   Second multiplier.
+    \param[out]     low                 Low 64 bits of the product.
 
-    return is_integer;
+    \return         High 64 bits of the product.
+*/
+static unsigned long long jfes_multiply_64(unsigned long long a, unsigned long long b, unsigned long long *low) {
+#if defined(__SIZEOF_INT128__)
+    const jfes_uint128_t product = (jfes_uint128_t)a * b;
+    *low = (unsigned long long)product;
+    return (unsigned long long)(product >> 64);
+#else
+    const unsigned long long a_low = a & 0xFFFFFFFFULL;
+    const unsigned long long a_high = a >> 32;
+    const unsigned long long b_low = b & 0xFFFFFFFFULL;
+    const unsigned long long b_high = b >> 32;
+
+    const unsigned long long low_low = a_low * b_low;
+    const unsigned long long low_high = a_low * b_high;
+    const unsigned long long high_low = a_high * b_low;
+    const unsigned long long high_high = a_high * b_high;
+
+    const unsigned long long middle = (low_low >> 32) + (low_high & 0xFFFFFFFFULL) + (high_low & 0xFFFFFFFFULL);
+    *low = (middle << 32) | (low_low & 0xFFFFFFFFULL);
+    return high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+#endif
 }
 
 /**
-    Analyzes input string on the subject of whether it is a double.
+    Converts decimal mantissa and exponent to the correctly rounded double
+    with the Eisel-Lemire algorithm.
 
-    \param[in]      data                Input string.
-    \param[in]      length              Optional. String length. You can pass zero
-                                        if `data` is a null-terminated string.
+    \param[in]      mantissa            Non-zero decimal mantissa.
+    \param[in]      exponent            Decimal exponent.
+    \param[in]      negative            Non-zero if the value is negative.
+    \param[out]     result              Double value.
 
-    \return         Zero if input string is not a double. Otherwise anything.
+    \return         Zero if the result can't be proven correct and the exact conversion is needed.
 */
-static int jfes_is_double(const char *data, jfes_size_t length) {
-    if (!data) {
+static int jfes_eisel_lemire(unsigned long long mantissa, int exponent, int negative, double *result) {
+    if (exponent < JFES_POWERS_OF_TEN_MIN || exponent > JFES_POWERS_OF_TEN_MAX) {
         return 0;
     }
 
-    if (length == 0) {
-        length = jfes_strlen(data);
-    }
+    const unsigned long long *power = jfes_powers_of_ten[exponent - JFES_POWERS_OF_TEN_MIN];
 
-    jfes_size_t offset = 0;
-    if (data[0] == '-') {
-        offset = 1;
-    }
+    const int leading_zeros = jfes_count_leading_zeros(mantissa);
+    mantissa <<= leading_zeros;
 
-    int dot_already_been = 0;
-    int exp_already_been = 0;
+    /* floor(exponent * log2(10)) without the right shift of the negative value. */
+    const int exponent_log2 = exponent >= 0 ? (217706 * exponent) >> 16 : -((-217706 * exponent + 65535) >> 16);
+    unsigned long long binary_exponent = (unsigned long long)(exponent_log2 + 64 + 1023 - leading_zeros);
 
-    for (jfes_size_t i = offset; i < length; i++) {
-        if (data[i] < '0' || data[i] > '9') {
-            if (data[i] == '.' && !dot_already_been) {
-                dot_already_been = 1;
-                continue;
-            }
-            else if ((data[i] == 'e' || data[i] == 'E') && i + 2 < length &&
-                (data[i + 1] == '+' || data[i + 1] == '-') && !exp_already_been) {
-                exp_already_been = 1;
-                i++;
-                continue;
-            }
+    unsigned long long low = 0;
+    unsigned long long high = jfes_multiply_64(mantissa, power[0], &low);
+
+    /* The truncated power of ten is not enough: take its low bits into account. */
+    if ((high & 0x1FF) == 0x1FF && low + mantissa < mantissa) {
+        unsigned long long extra_low = 0;
+        const unsigned long long extra_high = jfes_multiply_64(mantissa, power[1], &extra_low);
+
+        unsigned long long merged_high = high;
+        const unsigned long long merged_low = low + extra_high;
+        if (merged_low < low) {
+            merged_high++;
+        }
 
+        if ((merged_high & 0x1FF) == 0x1FF && merged_low + 1 == 0 && extra_low + mantissa < mantissa) {
             return 0;
         }
+
+        high = merged_high;
+        low = merged_low;
     }
 
-    return 1;
-}
+    const unsigned long long top_bit = high >> 63;
+    unsigned long long result_mantissa = high >> (top_bit + 9);
+    binary_exponent -= 1 ^ top_bit;
 
-/**
-    Analyzes string and returns its boolean value.
+    /* Can't decide the halfway case. */
+    if (low == 0 && (high & 0x1FF) == 0 && (result_mantissa & 3) == 1) {
+        return 0;
+    }
 
-    \param[in]      data                String for analysis.
-    \param[in]      length              Optional. String length. You can pass zero
-                                        if `data` is a null-terminated string;
+    result_mantissa += result_mantissa & 1;
+    result_mantissa >>= 1;
+    if (result_mantissa >> 53) {
+        result_mantissa >>= 1;
+        binary_exponent++;
+    }
 
-    \return         1 if data == 'true'. Otherwise 0.
-*/
-static int jfes_string_to_boolean(const char *data, jfes_size_t length) {
-    if (!data) {
+    /* Subnormal numbers and overflows are left to the exact conversion. */
+    if (binary_exponent - 1 >= 0x7FF - 1) {
         return 0;
     }
 
-    if (length == 0) {
-        length = jfes_strlen(data);
-    }
+    *result = jfes_make_double(negative, binary_exponent, result_mantissa);
+    return 1;
+}
 
-    if (length == jfes_strlen(JFES_TRUE_VALUE) && jfes_memcmp(data, JFES_TRUE_VALUE, length) == 0) {
-        return 1;
+/**
+    Removes trailing zeros of the decimal.
+
+    \param[in, out] decimal             Decimal to trim.
+*/
+static void jfes_decimal_trim(jfes_decimal_t *decimal) {
+    while (decimal->count > 0 && decimal->digits[decimal->count - 1] == 0) {
+        decimal->count--;
     }
 
-    return 0;
+    if (decimal->count == 0) {
+        decimal->point = 0;
+    }
 }
 
-/** 
-    Analyzes string and returns the integer type.
+/**
+    Reads the decimal from the double literal.
 
-    \param[in]      data                String for analysis.
-    \param[in]      length              Optional. String length. You can pass zero
-                                        if `data` is a null-terminated string.
+    \param[out]     decimal             Decimal to fill.
+    \param[in]      data                Valid double literal.
+    \param[in]      length              Literal length.
 
-    \return         Integer type.
+    \return         Non-zero if the value is negative.
 */
-static jfes_integer_type_t jfes_get_integer_type(const char *data, jfes_size_t length) {
-    if (!data) {
-        return jfes_not_integer;
-    }
+static int jfes_decimal_assign(jfes_decimal_t *decimal, const char *data, jfes_size_t length) {
+    decimal->count = 0;
+    decimal->point = 0;
+    decimal->truncated = 0;
 
-    if (length == 0) {
-        length = jfes_strlen(data);
+    jfes_size_t i = 0;
+    const int negative = data[0] == '-';
+    if (negative) {
+        i++;
     }
 
-    if (!jfes_is_integer(data, length)) {
-        return jfes_not_integer;
+    int has_point = 0;
+    for (; i < length; i++) {
+        if (data[i] == '.') {
+            has_point = 1;
+            decimal->point = (int)decimal->count;
+        }
+        else if (data[i] >= '0' && data[i] <= '9') {
+            if (data[i] == '0' && decimal->count == 0) {
+                decimal->point--;
+            }
+            else if (decimal->count < JFES_DECIMAL_DIGITS) {
+                decimal->digits[decimal->count++] = (unsigned char)(data[i] - '0');
+            }
+            else if (data[i] != '0') {
+                decimal->truncated = 1;
+            }
+        }
+        else {
+            break;
+        }
     }
 
-    jfes_size_t offset = 0;
-    if (data[0] == '-') {
-        offset = 1;
+    if (!has_point) {
+        decimal->point = (int)decimal->count;
     }
 
-    if (length > offset + 2) {
-        if (data[offset] == '0') {
-            if (data[offset + 1] == 'x' || data[offset + 1] == 'X') {
-                return jfes_hexadecimal_integer;
-            }
+    if (i < length) {
+        i++;
 
-            return jfes_octal_integer;
+        int exponent_sign = 1;
+        if (data[i] == '+' || data[i] == '-') {
+            exponent_sign = data[i] == '-' ? -1 : 1;
+            i++;
         }
+
+        int exponent = 0;
+        for (; i < length; i++) {
+            if (exponent < 10000) {
+                exponent = exponent * 10 + (data[i] - '0');
+            }
+        }
+        decimal->point += exponent_sign * exponent;
     }
 
-    return jfes_decimal_integer;
+    jfes_decimal_trim(decimal);
+    return negative;
 }
 
 /**
-    Analyses string and returns its integer value.
-
-    \param[in]      data                String for analysis. Can be decimal, octal or hexadecimal.
-    \param[in]      length              Optional. String length. You can pass zero
-                                        if `data` is a null-terminated string.
+    Multiplies the decimal by 2^shift.
 
-    \return         Integer representation of the input data.
-
-    \warning        This function doesn't check if the string is a correct integer, it's just ignoring
-                    all incorrect characters. If you aren't sure of the correctness of the input arguments,
-                    check them by `jfes_is_integer()` function.
+    \param[in, out] decimal             Non-zero decimal.
+    \param[in]      shift               Binary shift. Not greater than `JFES_DECIMAL_MAX_SHIFT`.
 */
-static int jfes_string_to_integer(const char *data, jfes_size_t length) {
-    if (!data) {
-        return 0;
-    }
+static void jfes_decimal_left_shift(jfes_decimal_t *decimal, unsigned int shift) {
+    jfes_size_t read = decimal->count;
+    jfes_size_t write = decimal->count + JFES_DECIMAL_SHIFT_DIGITS;
 
-    if (length == 0) {
-        length = jfes_strlen(data);
+    unsigned long long n = 0;
+    while (read > 0) {
+        n += (unsigned long long)decimal->digits[--read] << shift;
+        const unsigned long long quotient = n / 10;
+        decimal->digits[--write] = (unsigned char)(n - 10 * quotient);
+        n = quotient;
     }
 
-    int result = 0;
-    int sign = 1;
-
-    jfes_integer_type_t base = jfes_get_integer_type(data, length);
-    if (base == jfes_not_integer) {
-        return 0;
+    while (n > 0) {
+        const unsigned long long quotient = n / 10;
+        decimal->digits[--write] = (unsigned char)(n - 10 * quotient);
+        n = quotient;
     }
 
-    jfes_size_t offset = 0;
-
-    if (data[0] == '-') {
-        sign = -1;
-        offset = 1;
+    const jfes_size_t count = decimal->count + JFES_DECIMAL_SHIFT_DIGITS - write;
+    for (jfes_size_t i = 0; i < count; i++) {
+        decimal->digits[i] = decimal->digits[write + i];
     }
 
-    for (jfes_size_t i = offset; i < length; i++) {
-        char c = data[i];
-        if ((c >= '0' && c <= '9') || (base == jfes_hexadecimal_integer && 
-            ((c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')))) {
-            int value = 0;
-            if (c >= '0' && c <= '9') {
-                value = c - '0';
-            }
-            else if (c >= 'A' && c <= 'F') {
-                value = c - 'A' + 10;
-            }
-            else if (c >= 'a' && c <= 'f') {
-                value = c - 'a' + 10;
-            }
-            result = result * (int)base + value;
+    decimal->point += (int)(count - decimal->count);
+    decimal->count = count;
+
+    if (decimal->count > JFES_DECIMAL_DIGITS) {
+        for (jfes_size_t i = JFES_DECIMAL_DIGITS; i < decimal->count; i++) {
+            decimal->truncated = decimal->truncated || decimal->digits[i] != 0;
         }
+        decimal->count = JFES_DECIMAL_DIGITS;
     }
 
-    return result * sign;
+    jfes_decimal_trim(decimal);
 }
 
 /**
-    Analyses string and returns its double value.
-
-    \param[in]      data                String for analysis.
-    \param[in]      length              Optional. String length. You can pass zero
-                                        if `data` is a null-terminated string.
-
-    \return         Double representation of the input data.
+    Divides the decimal by 2^shift.
 
-    \warning        This function doen't check that string is correct floating point value, it's just ignoring
-                    all incorrect characters. If you aren't sure of the correctness of the input arguments,
-                    check them by `jfes_is_double()` function.
+    \param[in, out] decimal             Non-zero decimal.
+    \param[in]      shift               Binary shift. Not greater than `JFES_DECIMAL_MAX_SHIFT`.
 */
-static double jfes_string_to_double(const char *data, jfes_size_t length) {
-    if (!data) {
-        return 0.0;
-    }
-
-    double result = 0.0;
-    double sign = 1.0;
-
-    int after_dot = 0;
-    int exp = 0;
-
-    int direction = 0;
-
-    jfes_size_t index = 0;
+static void jfes_decimal_right_shift(jfes_decimal_t *decimal, unsigned int shift) {
+    jfes_size_t read = 0;
+    jfes_size_t write = 0;
+
+    unsigned long long n = 0;
+    for (; (n >> shift) == 0; read++) {
+        if (read >= decimal->count) {
+            if (n == 0) {
+                decimal->count = 0;
+                decimal->point = 0;
+                return;
+            }
 
-    if (length == 0) {
-        length = jfes_strlen(data);
+            while ((n >> shift) == 0) {
+                n *= 10;
+                read++;
+            }
+            break;
+        }
+        n = n * 10 + decimal->digits[read];
     }
 
-    if (data[0] == '-') {
-        sign = -1.0;
-        index = 1;
+    decimal->point -= (int)read - 1;
+
+    const unsigned long long mask = (1ULL << shift) - 1;
+    for (; read < decimal->count; read++) {
+        const unsigned char digit = decimal->digits[read];
+        decimal->digits[write++] = (unsigned char)(n >> shift);
+        n = (n & mask) * 10 + digit;
     }
 
-    for (; index < length; index++) {
-        char c = data[index];
-        if (c >= '0' && c <= '9') {
-            result = result * 10.0 + (c - '0');
-            if (after_dot) {
-                exp--;
-            }
-        } 
-        else if (c == '.') {
-            after_dot = 1;
-            continue;
+    while (n > 0) {
+        const unsigned char digit = (unsigned char)(n >> shift);
+        if (write < JFES_DECIMAL_DIGITS) {
+            decimal->digits[write++] = digit;
         }
-        else if (index + 2 < length && (c == 'e' || c == 'E')) {
-            index++;
-            if (data[index] == '+') {
-                direction = 1;
-                index++;
-            }
-            else if (data[index] == '-') {
-                direction = -1;
-                index++;
-            }
-            break;
+        else if (digit > 0) {
+            decimal->truncated = 1;
         }
+        n = (n & mask) * 10;
     }
 
-    if (index < length) {
-        if (jfes_is_integer(data + index, length - index)) {
-            int new_exp = jfes_string_to_integer(data + index, length - index);
-            exp += direction * new_exp;
-        }
+    decimal->count = write;
+    jfes_decimal_trim(decimal);
+}
+
+/**
+    Multiplies the decimal by 2^shift.
+
+    \param[in, out] decimal             Decimal to shift.
+    \param[in]      shift               Binary shift. Negative value means division.
+*/
+static void jfes_decimal_shift(jfes_decimal_t *decimal, int shift) {
+    if (decimal->count == 0) {
+        return;
     }
 
-    while (exp < 0) {
-        result /= 10.0;
-        exp++;
+    for (; shift > JFES_DECIMAL_MAX_SHIFT; shift -= JFES_DECIMAL_MAX_SHIFT) {
+        jfes_decimal_left_shift(decimal, JFES_DECIMAL_MAX_SHIFT);
     }
-    while (exp > 0) {
-        result *= 10.0;
-        exp--;
+    for (; shift < -JFES_DECIMAL_MAX_SHIFT; shift += JFES_DECIMAL_MAX_SHIFT) {
+        jfes_decimal_right_shift(decimal, JFES_DECIMAL_MAX_SHIFT);
     }
 
-    return sign * result;
+    if (shift > 0) {
+        jfes_decimal_left_shift(decimal, (unsigned int)shift);
+    }
+    else if (shift < 0) {
+        jfes_decimal_right_shift(decimal, (unsigned int)-shift);
+    }
 }
 
 /**
-    Returns boolean value as string.
+    Rounds the decimal to the nearest integer, ties to even.
 
-    \param[in]      value               Value to stringify.
+    \param[in]      decimal             Decimal less than 2^64.
 
-    \return         String representation of the given value.
+    \return         Rounded integer.
 */
-static const char *jfes_boolean_to_string(int value) {
-    return value ? JFES_TRUE_VALUE : JFES_FALSE_VALUE;
+static unsigned long long jfes_decimal_rounded_integer(const jfes_decimal_t *decimal) {
+    unsigned long long n = 0;
+    int i = 0;
+    for (; i < decimal->point && i < (int)decimal->count; i++) {
+        n = n * 10 + decimal->digits[i];
+    }
+    for (; i < decimal->point; i++) {
+        n *= 10;
+    }
+
+    const int point = decimal->point;
+    if (point >= 0 && point < (int)decimal->count) {
+        if (decimal->digits[point] == 5 && point + 1 == (int)decimal->count) {
+            if (decimal->truncated || (point > 0 && (decimal->digits[point - 1] & 1))) {
+                n++;
+            }
+        }
+        else if (decimal->digits[point] >= 5) {
+            n++;
+        }
+    }
+
+    return n;
 }
 
 /**
-    Thread safe version of the `jfes_integer_to_string`.
-
-    \param[in]      value               Value to stringify.
-    \param[out]     output              Output buffer to store result.
-    \param[in]      output_size         Maximal size of output buffer.
+    Converts the double literal to the correctly rounded double with the
+    arbitrary precision arithmetic. Slow, but exact for any input.
 
-    \return         String representation of the given value.
+    \param[in]      data                Valid double literal.
+    \param[in]      length              Literal length.
 
-    \warning        output_size must be greater than 1, because the output will be
-    null-terminated (if `output_size == 1`, then this single byte will be '\0').
+    \return         Double value.
 */
-static char *jfes_integer_to_string_r(int value, char *output, jfes_size_t output_size) {
-    if (!output || output_size <= 1) {
-        return JFES_NULL;
-    }
+static double jfes_decimal_to_double(const char *data, jfes_size_t length) {
+    /* Binary shifts which keep the decimal point at the given position. */
+    static const int shifts[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+    const int shifts_count = (int)(sizeof(shifts) / sizeof(shifts[0]));
 
-    char *p = &output[0] + output_size;
-    *--p = '\0';
+    jfes_decimal_t decimal;
+    const int negative = jfes_decimal_assign(&decimal, data, length);
 
-    jfes_size_t number_length = 0;
-
-    int sign = 1;
-    if (value < 0) {
-        sign = -1;
+    if (decimal.count == 0 || decimal.point < -330) {
+        return jfes_make_double(negative, 0, 0);
+    }
+    if (decimal.point > 310) {
+        return jfes_make_double(negative, 0x7FF, 0);
     }
 
-    do {
-        *--p = '0' + (char)(sign * (value % 10));
-        value /= 10;
-        number_length++;
-    } while (value != 0 && p > output);
-
-    if (sign < 0 && p > output) {
-        *--p = '-';
-        number_length++;
+    int exponent = 0;
+    while (decimal.point > 0) {
+        const int shift = decimal.point >= shifts_count ? 27 : shifts[decimal.point];
+        jfes_decimal_shift(&decimal, -shift);
+        exponent += shift;
+    }
+    while (decimal.point < 0 || (decimal.point == 0 && decimal.digits[0] < 5)) {
+        const int shift = -decimal.point >= shifts_count ? 27 : shifts[-decimal.point];
+        jfes_decimal_shift(&decimal, shift);
+        exponent -= shift;
     }
 
-    if (p == output && value != 0) {
-        return JFES_NULL;
+    /* Now the decimal is in [0.5, 1): the binary exponent is known. */
+    exponent--;
+    if (exponent < -1022) {
+        const int shift = -1022 - exponent;
+        jfes_decimal_shift(&decimal, -shift);
+        exponent += shift;
+    }
+    if (exponent + 1023 >= 0x7FF) {
+        return jfes_make_double(negative, 0x7FF, 0);
     }
 
-    if (number_length + 1 < output_size) {
-        for (jfes_size_t i = 0; i < number_length + 1; i++) {
-            output[i] = *(p + i);
+    jfes_decimal_shift(&decimal, 53);
+    unsigned long long mantissa = jfes_decimal_rounded_integer(&decimal);
+    if (mantissa == (2ULL << 52)) {
+        mantissa >>= 1;
+        exponent++;
+        if (exponent + 1023 >= 0x7FF) {
+            return jfes_make_double(negative, 0x7FF, 0);
         }
     }
 
-    return output;
-}
-
-/**
-    Returns integer value as string.
-
-    \param[in]      value               Value to stringify.
+    /* No implicit bit means a subnormal number. */
+    if (!(mantissa & (1ULL << 52))) {
+        exponent = -1023;
+    }
 
-    \return         String representation of the given value.
-*/
-static char *jfes_integer_to_string(int value) {
-    static char buf[JFES_MAX_DIGITS + 1];
-    return jfes_integer_to_string_r(value, &buf[0], JFES_MAX_DIGITS);
+    return jfes_make_double(negative, (unsigned long long)(exponent + 1023), mantissa);
 }
 
 /**
-    Thread safe version of the `jfes_double_to_string`.
-
-    \param[in]      value               Value to stringify.
-    \param[out]     output              Output buffer to store result.
-    \param[in]      output_size         Maximal size of output buffer.
-    \param[in]      precision_eps       Double precision (like 0.00001).
+    Builds correctly rounded double value from the decimal mantissa and exponent.
 
-    \return         String representation of the given value.
+    \param[in]      data                Double literal, used by the exact conversion.
+    \param[in]      length              Literal length.
+    \param[in]      mantissa            First `JFES_MANTISSA_DIGITS` significant digits.
+    \param[in]      exponent            Decimal exponent.
+    \param[in]      truncated           Non-zero if some significant digits were dropped from the mantissa.
+    \param[in]      negative            Non-zero if the value is negative.
 
-    \warning        output_size must be greater than 1, because the output will be
-    null-terminated (if `output_size == 1`, then this single byte will be '\0').
+    \return         Double value.
 */
-static char *jfes_double_to_string_r(double value, char *output, jfes_size_t output_size, double precision_eps) {
-    if (!output || output_size <= 1) {
-        return JFES_NULL;
+static double jfes_compose_double(const char *data, jfes_size_t length, unsigned long long mantissa,
+    int exponent, int truncated, int negative) {
+    if (mantissa == 0) {
+        return jfes_make_double(negative, 0, 0);
     }
 
-    int int_value = (int)value;
-    double fractional_value = value - int_value;
-    if (fractional_value < 0) {
-        fractional_value = -fractional_value;
-    }
-
-    double precision = precision_eps;
-    while (precision < 1.0) {
-        fractional_value *= 10;
-        if (fractional_value - (int)fractional_value < precision_eps) {
-            break;
+    double result = 0.0;
+    if (!truncated) {
+        /* Both mantissa and power of ten are exact, so one operation gives the correctly rounded result. */
+        if (mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+            result = (double)mantissa;
+            result = exponent < 0 ? result / jfes_exact_powers_of_ten[-exponent] : result * jfes_exact_powers_of_ten[exponent];
+            return negative ? -result : result;
         }
 
-        precision *= 10.0;
+        if (jfes_eisel_lemire(mantissa, exponent, negative, &result)) {
+            return result;
+        }
     }
-
-    int fractional_int = (int)fractional_value;
-
-    char *int_value_s = jfes_integer_to_string_r(int_value, &output[0], output_size);
-    if (!int_value_s) {
-        return JFES_NULL;
+    else {
+        /* The value is between mantissa and mantissa + 1, so both of them must give the same result. */
+        double upper = 0.0;
+        if (jfes_eisel_lemire(mantissa, exponent, negative, &result)
+            && jfes_eisel_lemire(mantissa + 1, exponent, negative, &upper) && result == upper) {
+            return result;
+        }
     }
-    jfes_size_t value_length = jfes_strlen(int_value_s);
 
-    output[value_length] = '.';
+    return jfes_decimal_to_double(data, length);
+}
 
-    char *fractional_value_s = jfes_integer_to_string_r(fractional_int, 
-        &output[value_length + 1], output_size - value_length - 1);
-    if (!fractional_value_s) {
-        return JFES_NULL;
-    }
+/**
+    Loads 8 bytes as the little-endian 64-bit value.
 
-    return &output[0];
+    \param[in]      data                At least 8 bytes.
+
+    \return         Loaded value.
+*/
+static unsigned long long jfes_load_eight_bytes(const char *data) {
+    const unsigned char *bytes = (const unsigned char *)data;
+
+    /* Compilers merge this into the one load on little-endian platforms. */
+    return (unsigned long long)bytes[0] | ((unsigned long long)bytes[1] << 8)
+        | ((unsigned long long)bytes[2] << 16) | ((unsigned long long)bytes[3] << 24)
+        | ((unsigned long long)bytes[4] << 32) | ((unsigned long long)bytes[5] << 40)
+        | ((unsigned long long)bytes[6] << 48) | ((unsigned long long)bytes[7] << 56);
 }
 
 /**
-    Returns double value as string.
+    Checks that all 8 bytes of the chunk are decimal digits.
 
-    \param[in]      value               Value to stringify.
+    \param[in]      chunk               Bytes loaded by jfes_load_eight_bytes.
 
-    \return         String representation of the given value.
+    \return         Non-zero if all bytes are digits.
 */
-static char *jfes_double_to_string(double value) {
-    static char buf[JFES_MAX_DIGITS];
-
-    static double precision_eps = JFES_DOUBLE_PRECISION;
-    return jfes_double_to_string_r(value, &buf[0], JFES_MAX_DIGITS, precision_eps);
+static int jfes_is_eight_digits(unsigned long long chunk) {
+    return ((chunk & 0xF0F0F0F0F0F0F0F0ULL)
+        | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
 }
 
 /**
-    Initializes jfes_stringstream object.
+    Converts 8 decimal digits at once: pairs, then quads, then the whole number.
 
-    \param[out]     stream              Object to initialize.
-    \param[in]      data                Pointer to the memory.
-    \param[in]      max_size            Size of the allocated memory.
+    \param[in]      chunk               Bytes loaded by jfes_load_eight_bytes. Must be digits.
 
-    \return         jfes_success if everything is OK.
+    \return         Value of the 8 digits.
 */
-static jfes_status_t jfes_initialize_stringstream(jfes_stringstream_t *stream, char *data, jfes_size_t max_size) {
-    if (!stream || !data || max_size == 0) {
-        return jfes_invalid_arguments;
-    }
+static unsigned long long jfes_parse_eight_digits(unsigned long long chunk) {
+    chunk -= 0x3030303030303030ULL;
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)))
+        + (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
 
-    stream->data = data;
-    stream->max_size = max_size;
-    stream->current_index = 0;
-
-    return jfes_success;
+    return chunk & 0xFFFFFFFFULL;
 }
 
 /**
-    Adds given data to the given stream.
+    Classifies the primitive and decodes its value in one pass.
+    Integers can be decimal, octal (`017`) or hexadecimal (`0x1F`) if `JFES_DECIMAL_ONLY` is not defined.
+    Doubles need a fraction or an exponent: `1.5`, `.5`, `2.`, `1e5`, `1E-5`.
+    Decimal integers out of the jfes_integer_t range become doubles.
 
-    \param[out]     stream              Stringstream object.
-    \param[in]      data                Data to add.
+    \param[in]      data                Primitive bytes.
+    \param[in]      length              Primitive length.
+    \param[out]     value               Optional. Decoded value. Pass JFES_NULL if you need only the type.
+
+    \return         Primitive type or `jfes_type_undefined`.
+*/
+static jfes_token_type_t jfes_read_primitive(const char *data, jfes_size_t length, jfes_token_value_t *value) {
+    if (!data || length == 0) {
+        return jfes_type_undefined;
+    }
+
+    switch (data[0]) {
+    case 'n':
+        return length == 4 && jfes_memcmp(data, JFES_NULL_VALUE, 4) == 0 ? jfes_type_null : jfes_type_undefined;
+
+    case 't': case 'f':
+        if (length == 4 && jfes_memcmp(data, JFES_TRUE_VALUE, 4) == 0) {
+            if (value) {
+                value->bool_val = 1;
+            }
+            return jfes_type_boolean;
+        }
+        else if (length == 5 && jfes_memcmp(data, JFES_FALSE_VALUE, 5) == 0) {
+            if (value) {
+                value->bool_val = 0;
+            }
+            return jfes_type_boolean;
+        }
+        return jfes_type_undefined;
+
+    default:
+        break;
+    }
+
+    jfes_size_t i = 0;
+    int negative = 0;
+    if (data[0] == '-') {
+        negative = 1;
+        i = 1;
+    }
+
+    /* Magnitude of the most negative integer. */
+    const unsigned long long max_integer = (~0ULL >> 1) + (negative ? 1 : 0);
+
+#ifndef JFES_DECIMAL_ONLY
+    if (i + 1 < length && data[i] == '0'
+        && (data[i + 1] == 'x' || data[i + 1] == 'X' || (data[i + 1] >= '0' && data[i + 1] <= '9'))) {
+        const int hexadecimal = data[i + 1] == 'x' || data[i + 1] == 'X';
+        const unsigned long long base = hexadecimal ? 16 : 8;
+
+        unsigned long long integer = 0;
+        int invalid = 0;
+
+        jfes_size_t j = i + (hexadecimal ? 2 : 1);
+        for (; j < length; j++) {
+            const int digit = jfes_hex_digit_value(data[j]);
+            if (digit < 0 || (!hexadecimal && digit > 9)) {
+                break;
+            }
+
+            invalid = invalid || (unsigned long long)digit >= base
+                || integer > (max_integer - (unsigned long long)digit) / base;
+            integer = integer * base + (unsigned long long)digit;
+        }
+
+        if (j == length) {
+            if (invalid || (hexadecimal && j == i + 2)) {
+                return jfes_type_undefined;
+            }
+
+            if (value) {
+                value->int_val = (jfes_integer_t)(negative ? 0ULL - integer : integer);
+            }
+            return jfes_type_integer;
+        }
+
+        /* Leading zero means octal integer, but decimal double: `017` is 15, `017.5` is 17.5. */
+        if (hexadecimal) {
+            return jfes_type_undefined;
+        }
+    }
+#else
+    /* Decimal numbers have no leading zeros: `0123` is not `123`. */
+    if (i + 1 < length && data[i] == '0' && data[i + 1] >= '0' && data[i + 1] <= '9') {
+        return jfes_type_undefined;
+    }
+#endif
+
+    /* First significant digits of the number. The rest only moves the exponent. */
+    unsigned long long mantissa = 0;
+    int significant_digits = 0;
+    int truncated = 0;
+    int exponent = 0;
+
+    const jfes_size_t integer_start = i;
+    while (i < length && data[i] == '0') {
+        i++;
+    }
+
+    while (i + 8 <= length && significant_digits + 8 <= JFES_MANTISSA_DIGITS) {
+        const unsigned long long chunk = jfes_load_eight_bytes(data + i);
+        if (!jfes_is_eight_digits(chunk)) {
+            break;
+        }
+
+        mantissa = mantissa * 100000000ULL + jfes_parse_eight_digits(chunk);
+        significant_digits += 8;
+        i += 8;
+    }
+
+    for (; i < length && data[i] >= '0' && data[i] <= '9'; i++) {
+        const unsigned int digit = (unsigned int)(data[i] - '0');
+        if (mantissa == 0 && digit == 0) {
+            continue;
+        }
+
+        if (significant_digits < JFES_MANTISSA_DIGITS) {
+            mantissa = mantissa * 10 + digit;
+            significant_digits++;
+        }
+        else {
+            truncated = truncated || digit != 0;
+            exponent++;
+        }
+    }
+
+    jfes_size_t digits = i - integer_start;
+
+    if (i == length) {
+        if (digits == 0) {
+            return jfes_type_undefined;
+        }
+
+        if (exponent == 0 && mantissa <= max_integer) {
+            if (value) {
+                value->int_val = (jfes_integer_t)(negative ? 0ULL - mantissa : mantissa);
+            }
+            return jfes_type_integer;
+        }
+
+        if (value) {
+            value->double_val = jfes_compose_double(data, length, mantissa, exponent, truncated, negative);
+        }
+        return jfes_type_double;
+    }
+
+    if (data[i] == '.') {
+        const jfes_size_t fraction_start = ++i;
+        if (value) {
+            for (; i < length && data[i] >= '0' && data[i] <= '9'; i++) {
+                const unsigned int digit = (unsigned int)(data[i] - '0');
+                if (mantissa == 0 && digit == 0) {
+                    exponent--;
+                }
+                else if (significant_digits < JFES_MANTISSA_DIGITS) {
+                    mantissa = mantissa * 10 + digit;
+                    significant_digits++;
+                    exponent--;
+                }
+                else {
+                    truncated = truncated || digit != 0;
+                }
+            }
+        }
+        else {
+            while (i < length && data[i] >= '0' && data[i] <= '9') {
+                i++;
+            }
+        }
+        digits += i - fraction_start;
+    }
+
+    if (digits == 0) {
+        return jfes_type_undefined;
+    }
+
+    if (i < length && (data[i] == 'e' || data[i] == 'E')) {
+        i++;
+
+        int exponent_sign = 1;
+        if (i < length && (data[i] == '+' || data[i] == '-')) {
+            exponent_sign = data[i] == '-' ? -1 : 1;
+            i++;
+        }
+
+        if (i == length) {
+            return jfes_type_undefined;
+        }
+
+        int exponent_value = 0;
+        for (; i < length && data[i] >= '0' && data[i] <= '9'; i++) {
+            if (exponent_value < 100000) {
+                exponent_value = exponent_value * 10 + (data[i] - '0');
+            }
+        }
+        exponent += exponent_sign * exponent_value;
+    }
+
+    if (i != length) {
+        return jfes_type_undefined;
+    }
+
+    if (value) {
+        value->double_val = jfes_compose_double(data, length, mantissa, exponent, truncated, negative);
+    }
+    return jfes_type_double;
+}
+
+/**
+    Returns boolean value as string.
+
+    \param[in]      value               Value to stringify.
+
+    \return         String representation of the given value.
+*/
+static const char *jfes_boolean_to_string(int value) {
+    return value ? JFES_TRUE_VALUE : JFES_FALSE_VALUE;
+}
+
+/** Two-digit decimal representations of 00..99. */
+static const char jfes_digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/**
+    Calculates length of the decimal representation of the integer.
+
+    \param[in]      value               Value to measure.
+
+    \return         Length with the sign.
+*/
+static jfes_size_t jfes_integer_length(jfes_integer_t value) {
+    const unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+
+    /* The 64-bit magnitude has 19 digits at most, so the threshold doesn't overflow. */
+    jfes_size_t digits = 1;
+    unsigned long long threshold = 10;
+    while (digits < 19 && magnitude >= threshold) {
+        threshold *= 10;
+        digits++;
+    }
+
+    return digits + (value < 0 ? 1 : 0);
+}
+
+/**
+    Writes decimal representation of the integer, two digits per step
+    from the end of the output.
+
+    \param[in]      value               Value to stringify.
+    \param[out]     output              Output buffer with at least `length` bytes.
+                                        Result is not null-terminated.
+    \param[in]      length              Representation length, see jfes_integer_length.
+*/
+static void jfes_write_integer(jfes_integer_t value, char *output, jfes_size_t length) {
+    char *p = output + length;
+
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    while (magnitude >= 100) {
+        const char *pair = &jfes_digit_pairs[(magnitude % 100) * 2];
+        magnitude /= 100;
+        *--p = pair[1];
+        *--p = pair[0];
+    }
+
+    if (magnitude >= 10) {
+        const char *pair = &jfes_digit_pairs[magnitude * 2];
+        *--p = pair[1];
+        *--p = pair[0];
+    }
+    else {
+        *--p = (char)('0' + magnitude);
+    }
+
+    if (value < 0) {
+        *--p = '-';
+    }
+}
+
+/** Binary exponent range of the scaled value in the Grisu2 algorithm. */
+#define JFES_GRISU_ALPHA                -60
+#define JFES_GRISU_GAMMA                -32
+
+/** Decimal exponent of the first cached power and the step between cached powers. */
+#define JFES_CACHED_POWERS_MIN_EXPONENT -300
+#define JFES_CACHED_POWERS_STEP         8
+
+/** Smallest and largest decimal exponents printed without the exponent part. */
+#define JFES_DOUBLE_MIN_FIXED_EXPONENT  -4
+#define JFES_DOUBLE_MAX_FIXED_EXPONENT  15
+
+/** Floating-point number with 64-bit significand: f * 2^e. */
+typedef struct jfes_diy_fp {
+    unsigned long long      f;                  /**< Significand. */
+    int                     e;                  /**< Binary exponent. */
+} jfes_diy_fp_t;
+
+/** Cached power of ten: f * 2^e approximates 10^k. */
+typedef struct jfes_cached_power {
+    unsigned long long      f;                  /**< Normalized significand. */
+    int                     e;                  /**< Binary exponent. */
+    int                     k;                  /**< Decimal exponent. */
+} jfes_cached_power_t;
+
+/** Powers of ten from 1e-300 to 1e324 with step 1e8. */
+static const jfes_cached_power_t jfes_cached_powers[] = {
+    { 0xAB70FE17C79AC6CAULL, -1060, -300 },
+    { 0xFF77B1FCBEBCDC4FULL, -1034, -292 },
+    { 0xBE5691EF416BD60CULL, -1007, -284 },
+    { 0x8DD01FAD907FFC3CULL,  -980, -276 },
+    { 0xD3515C2831559A83ULL,  -954, -268 },
+    { 0x9D71AC8FADA6C9B5ULL,  -927, -260 },
+    { 0xEA9C227723EE8BCBULL,  -901, -252 },
+    { 0xAECC49914078536DULL,  -874, -244 },
+    { 0x823C12795DB6CE57ULL,  -847, -236 },
+    { 0xC21094364DFB5637ULL,  -821, -228 },
+    { 0x9096EA6F3848984FULL,  -794, -220 },
+    { 0xD77485CB25823AC7ULL,  -768, -212 },
+    { 0xA086CFCD97BF97F4ULL,  -741, -204 },
+    { 0xEF340A98172AACE5ULL,  -715, -196 },
+    { 0xB23867FB2A35B28EULL,  -688, -188 },
+    { 0x84C8D4DFD2C63F3BULL,  -661, -180 },
+    { 0xC5DD44271AD3CDBAULL,  -635, -172 },
+    { 0x936B9FCEBB25C996ULL,  -608, -164 },
+    { 0xDBAC6C247D62A584ULL,  -582, -156 },
+    { 0xA3AB66580D5FDAF6ULL,  -555, -148 },
+    { 0xF3E2F893DEC3F126ULL,  -529, -140 },
+    { 0xB5B5ADA8AAFF80B8ULL,  -502, -132 },
+    { 0x87625F056C7C4A8BULL,  -475, -124 },
+    { 0xC9BCFF6034C13053ULL,  -449, -116 },
+    { 0x964E858C91BA2655ULL,  -422, -108 },
+    { 0xDFF9772470297EBDULL,  -396, -100 },
+    { 0xA6DFBD9FB8E5B88FULL,  -369,  -92 },
+    { 0xF8A95FCF88747D94ULL,  -343,  -84 },
+    { 0xB94470938FA89BCFULL,  -316,  -76 },
+    { 0x8A08F0F8BF0F156BULL,  -289,  -68 },
+    { 0xCDB02555653131B6ULL,  -263,  -60 },
+    { 0x993FE2C6D07B7FACULL,  -236,  -52 },
+    { 0xE45C10C42A2B3B06ULL,  -210,  -44 },
+    { 0xAA242499697392D3ULL,  -183,  -36 },
+    { 0xFD87B5F28300CA0EULL,  -157,  -28 },
+    { 0xBCE5086492111AEBULL,  -130,  -20 },
+    { 0x8CBCCC096F5088CCULL,  -103,  -12 },
+    { 0xD1B71758E219652CULL,   -77,   -4 },
+    { 0x9C40000000000000ULL,   -50,    4 },
+    { 0xE8D4A51000000000ULL,   -24,   12 },
+    { 0xAD78EBC5AC620000ULL,     3,   20 },
+    { 0x813F3978F8940984ULL,    30,   28 },
+    { 0xC097CE7BC90715B3ULL,    56,   36 },
+    { 0x8F7E32CE7BEA5C70ULL,    83,   44 },
+    { 0xD5D238A4ABE98068ULL,   109,   52 },
+    { 0x9F4F2726179A2245ULL,   136,   60 },
+    { 0xED63A231D4C4FB27ULL,   162,   68 },
+    { 0xB0DE65388CC8ADA8ULL,   189,   76 },
+    { 0x83C7088E1AAB65DBULL,   216,   84 },
+    { 0xC45D1DF942711D9AULL,   242,   92 },
+    { 0x924D692CA61BE758ULL,   269,  100 },
+    { 0xDA01EE641A708DEAULL,   295,  108 },
+    { 0xA26DA3999AEF774AULL,   322,  116 },
+    { 0xF209787BB47D6B85ULL,   348,  124 },
+    { 0xB454E4A179DD1877ULL,   375,  132 },
+    { 0x865B86925B9BC5C2ULL,   402,  140 },
+    { 0xC83553C5C8965D3DULL,   428,  148 },
+    { 0x952AB45CFA97A0B3ULL,   455,  156 },
+    { 0xDE469FBD99A05FE3ULL,   481,  164 },
+    { 0xA59BC234DB398C25ULL,   508,  172 },
+    { 0xF6C69A72A3989F5CULL,   534,  180 },
+    { 0xB7DCBF5354E9BECEULL,   561,  188 },
+    { 0x88FCF317F22241E2ULL,   588,  196 },
+    { 0xCC20CE9BD35C78A5ULL,   614,  204 },
+    { 0x98165AF37B2153DFULL,   641,  212 },
+    { 0xE2A0B5DC971F303AULL,   667,  220 },
+    { 0xA8D9D1535CE3B396ULL,   694,  228 },
+    { 0xFB9B7CD9A4A7443CULL,   720,  236 },
+    { 0xBB764C4CA7A44410ULL,   747,  244 },
+    { 0x8BAB8EEFB6409C1AULL,   774,  252 },
+    { 0xD01FEF10A657842CULL,   800,  260 },
+    { 0x9B10A4E5E9913129ULL,   827,  268 },
+    { 0xE7109BFBA19C0C9DULL,   853,  276 },
+    { 0xAC2820D9623BF429ULL,   880,  284 },
+    { 0x80444B5E7AA7CF85ULL,   907,  292 },
+    { 0xBF21E44003ACDD2DULL,   933,  300 },
+    { 0x8E679C2F5E44FF8FULL,   960,  308 },
+    { 0xD433179D9C8CB841ULL,   986,  316 },
+    { 0x9E19DB92B4E31BA9ULL,  1013,  324 }
+};
+
+/**
+    Builds jfes_diy_fp_t.
+
+    \param[in]      f                   Significand.
+    \param[in]      e                   Binary exponent.
+
+    \return         Built value.
+*/
+static jfes_diy_fp_t jfes_make_diy_fp(unsigned long long f, int e) {
+    jfes_diy_fp_t result;
+    result.f = f;
+    result.e = e;
+    return result;
+}
+
+/**
+    Multiplies two jfes_diy_fp_t values and rounds the result to 64 bits.
+
+    \param[in]      a                   First multiplier.
+    \param[in]      b                   Second multiplier.
+
+    \return         Product.
+*/
+static jfes_diy_fp_t jfes_multiply_diy_fp(jfes_diy_fp_t a, jfes_diy_fp_t b) {
+    unsigned long long low = 0;
+    const unsigned long long high = jfes_multiply_64(a.f, b.f, &low);
+    return jfes_make_diy_fp(high + (low >> 63), a.e + b.e + 64);
+}
+
+/**
+    Shifts the significand left until its most significant bit is set.
+
+    \param[in]      value               Non-zero value.
+
+    \return         Normalized value.
+*/
+static jfes_diy_fp_t jfes_normalize_diy_fp(jfes_diy_fp_t value) {
+    const int shift = jfes_count_leading_zeros(value.f);
+    return jfes_make_diy_fp(value.f << shift, value.e - shift);
+}
+
+/**
+    Rounds the last digit down while the result stays in the rounding interval
+    and gets closer to the exact value.
+
+    \param[in, out] buffer              Digits.
+    \param[in]      length              Digits count.
+    \param[in]      distance            Distance from the upper boundary to the exact value.
+    \param[in]      delta               Width of the rounding interval.
+    \param[in]      rest                Distance from the upper boundary to the generated digits.
+    \param[in]      ten_k               Weight of the last digit.
+*/
+static void jfes_grisu_round(char *buffer, int length, unsigned long long distance,
+    unsigned long long delta, unsigned long long rest, unsigned long long ten_k) {
+    while (rest < distance && delta - rest >= ten_k
+        && (rest + ten_k < distance || distance - rest > rest + ten_k - distance)) {
+        buffer[length - 1]--;
+        rest += ten_k;
+    }
+}
+
+/**
+    Generates the shortest digits of the positive double with the Grisu2 algorithm.
+    Result always reads back to the same double.
+
+    \param[in]      value               Positive finite value.
+    \param[out]     buffer              Buffer for at least 17 digits.
+    \param[out]     decimal_exponent    Decimal exponent: value is `digits * 10^decimal_exponent`.
+
+    \return         Digits count.
+*/
+static int jfes_grisu2(double value, char *buffer, int *decimal_exponent) {
+    jfes_double_bits_t bits;
+    bits.value = value;
+
+    const unsigned long long fraction = bits.bits & 0x000FFFFFFFFFFFFFULL;
+    const int biased_exponent = (int)(bits.bits >> 52);
+
+    /* Value and the boundaries of its rounding interval. */
+    const jfes_diy_fp_t v = biased_exponent == 0
+        ? jfes_make_diy_fp(fraction, 1 - 1075)
+        : jfes_make_diy_fp(fraction + (1ULL << 52), biased_exponent - 1075);
+
+    const jfes_diy_fp_t plus = jfes_normalize_diy_fp(jfes_make_diy_fp(2 * v.f + 1, v.e - 1));
+    jfes_diy_fp_t minus = fraction == 0 && biased_exponent > 1
+        ? jfes_make_diy_fp(4 * v.f - 1, v.e - 2)
+        : jfes_make_diy_fp(2 * v.f - 1, v.e - 1);
+    minus = jfes_make_diy_fp(minus.f << (minus.e - plus.e), plus.e);
+
+    /* Cached power of ten which scales the upper boundary exponent into [alpha, gamma]. */
+    const int f = JFES_GRISU_ALPHA - plus.e - 1;
+    const int k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+    const int index = (-JFES_CACHED_POWERS_MIN_EXPONENT + k + (JFES_CACHED_POWERS_STEP - 1)) / JFES_CACHED_POWERS_STEP;
+    const jfes_cached_power_t *cached = &jfes_cached_powers[index];
+    const jfes_diy_fp_t power = jfes_make_diy_fp(cached->f, cached->e);
+
+    const jfes_diy_fp_t w = jfes_multiply_diy_fp(jfes_normalize_diy_fp(v), power);
+    jfes_diy_fp_t w_minus = jfes_multiply_diy_fp(minus, power);
+    jfes_diy_fp_t w_plus = jfes_multiply_diy_fp(plus, power);
+
+    /* Products are not exact: shrink the interval to stay inside the real one. */
+    w_minus.f++;
+    w_plus.f--;
+
+    *decimal_exponent = -cached->k;
+
+    const int shift = -w_plus.e;
+    const unsigned long long one = 1ULL << shift;
+
+    unsigned int integral = (unsigned int)(w_plus.f >> shift);
+    unsigned long long fractional = w_plus.f & (one - 1);
+
+    unsigned long long delta = w_plus.f - w_minus.f;
+    unsigned long long distance = w_plus.f - w.f;
+
+    unsigned int power10 = 1000000000;
+    int integral_digits = 10;
+    while (integral_digits > 1 && integral < power10) {
+        power10 /= 10;
+        integral_digits--;
+    }
+
+    int length = 0;
+    while (integral_digits > 0) {
+        buffer[length++] = (char)('0' + integral / power10);
+        integral %= power10;
+        integral_digits--;
+
+        const unsigned long long rest = ((unsigned long long)integral << shift) + fractional;
+        if (rest <= delta) {
+            *decimal_exponent += integral_digits;
+            jfes_grisu_round(buffer, length, distance, delta, rest, (unsigned long long)power10 << shift);
+            return length;
+        }
+
+        power10 /= 10;
+    }
+
+    int fractional_digits = 0;
+    do {
+        fractional *= 10;
+        buffer[length++] = (char)('0' + (fractional >> shift));
+        fractional &= one - 1;
+        fractional_digits++;
+
+        delta *= 10;
+        distance *= 10;
+    } while (fractional > delta);
+
+    *decimal_exponent -= fractional_digits;
+    jfes_grisu_round(buffer, length, distance, delta, fractional, one);
+    return length;
+}
+
+/**
+    Prints the double into the buffer: the shortest representation which reads back to the same double.
+    Integral values keep `.0` to stay doubles, NaN and infinities become `null`.
+
+    \param[in]      value               Value to stringify.
+    \param[out]     output              Output buffer to store result.
+    \param[in]      output_size         Maximal size of output buffer.
+
+    \return         String representation of the given value.
+
+    \warning        output_size must be at least 32 bytes.
+*/
+static char *jfes_double_to_string_r(double value, char *output, jfes_size_t output_size) {
+    if (!output || output_size < 32) {
+        return JFES_NULL;
+    }
+
+    if (value != value || value - value != 0.0) {
+        jfes_memcpy(output, JFES_NULL_VALUE, 5);
+        return output;
+    }
+
+    char *p = output;
+
+    jfes_double_bits_t bits;
+    bits.value = value;
+    if (bits.bits >> 63) {
+        *p++ = '-';
+        value = -value;
+    }
+
+    if (value == 0.0) {
+        jfes_memcpy(p, "0.0", 4);
+        return output;
+    }
+
+    int decimal_exponent = 0;
+    const int length = jfes_grisu2(value, p, &decimal_exponent);
+
+    /* Value is `0.digits * 10^point`. */
+    const int point = length + decimal_exponent;
+
+    if (length <= point && point <= JFES_DOUBLE_MAX_FIXED_EXPONENT) {
+        /* digits[000].0 */
+        for (int i = length; i < point; i++) {
+            p[i] = '0';
+        }
+        p += point;
+        *p++ = '.';
+        *p++ = '0';
+    }
+    else if (0 < point && point <= JFES_DOUBLE_MAX_FIXED_EXPONENT) {
+        /* dig.its */
+        for (int i = length; i > point; i--) {
+            p[i] = p[i - 1];
+        }
+        p[point] = '.';
+        p += length + 1;
+    }
+    else if (JFES_DOUBLE_MIN_FIXED_EXPONENT < point && point <= 0) {
+        /* 0.[000]digits */
+        const int zeros = -point;
+        for (int i = length - 1; i >= 0; i--) {
+            p[i + 2 + zeros] = p[i];
+        }
+        p[0] = '0';
+        p[1] = '.';
+        for (int i = 0; i < zeros; i++) {
+            p[2 + i] = '0';
+        }
+        p += 2 + zeros + length;
+    }
+    else {
+        /* d.igitse+x */
+        if (length > 1) {
+            for (int i = length; i > 1; i--) {
+                p[i] = p[i - 1];
+            }
+            p[1] = '.';
+            p += length + 1;
+        }
+        else {
+            p++;
+        }
+
+        int exponent = point - 1;
+        *p++ = 'e';
+        *p++ = exponent < 0 ? '-' : '+';
+        if (exponent < 0) {
+            exponent = -exponent;
+        }
+
+        if (exponent >= 100) {
+            *p++ = (char)('0' + exponent / 100);
+            exponent %= 100;
+            *p++ = (char)('0' + exponent / 10);
+        }
+        else if (exponent >= 10) {
+            *p++ = (char)('0' + exponent / 10);
+        }
+        *p++ = (char)('0' + exponent % 10);
+    }
+
+    *p = '\0';
+    return output;
+}
+
+/**
+    Initializes jfes_stringstream object.
+
+    \param[out]     stream              Object to initialize.
+    \param[in]      data                Pointer to the memory.
+    \param[in]      max_size            Size of the allocated memory.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_initialize_stringstream(jfes_stringstream_t *stream, char *data, jfes_size_t max_size) {
+    if (!stream || !data || max_size == 0) {
+        return jfes_invalid_arguments;
+    }
+
+    stream->data = data;
+    stream->max_size = max_size;
+    stream->current_index = 0;
+
+    return jfes_success;
+}
+
+/**
+    Adds given data to the given stream.
+
+    \param[out]     stream              Stringstream object.
+    \param[in]      data                Data to add.
     \param[in]      data_length         Optional. Child key length. You can pass 0
                                         if the data string is zero-terminated.
     
@@ -700,570 +2187,4756 @@ static jfes_status_t jfes_add_to_stringstream(jfes_stringstream_t *stream, const
         return jfes_invalid_arguments;
     }
 
-    if (stream->current_index >= stream->max_size) {
-        return jfes_no_memory;
+    if (stream->current_index >= stream->max_size) {
+        return jfes_no_memory;
+    }
+
+    if (data_length == 0) {
+        data_length = jfes_strlen(data);
+    }
+    jfes_status_t status = jfes_success;
+
+    jfes_size_t size_to_add = data_length;
+    
+    if (stream->current_index + size_to_add > stream->max_size) {
+        size_to_add = stream->max_size - stream->current_index;
+        status = jfes_no_memory;
+    }
+
+    jfes_memcpy(stream->data + stream->current_index, data, size_to_add);
+
+    stream->current_index += size_to_add;
+    return status;
+}
+
+/**
+    Adds decimal representation of the integer to the given stream.
+    The space is reserved in the stream and the digits are written right into it.
+
+    \param[out]     stream              Stringstream object.
+    \param[in]      value               Value to add.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_add_integer_to_stringstream(jfes_stringstream_t *stream, jfes_integer_t value) {
+    if (!stream) {
+        return jfes_invalid_arguments;
+    }
+
+    const jfes_size_t length = jfes_integer_length(value);
+    if (stream->current_index >= stream->max_size || stream->max_size - stream->current_index < length) {
+        return jfes_no_memory;
+    }
+
+    jfes_write_integer(value, stream->data + stream->current_index, length);
+    stream->current_index += length;
+    return jfes_success;
+}
+
+/**
+    Adds the string to the stream as a JSON string body: quotes, backslashes
+    and control characters are escaped.
+
+    \param[in, out] stream              Stream to add.
+    \param[in]      data                String to add.
+    \param[in]      length              String length.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_add_escaped_to_stringstream(jfes_stringstream_t *stream, const char *data, jfes_size_t length) {
+    static const char *hex_digits = "0123456789abcdef";
+
+    jfes_size_t start = 0;
+    for (jfes_size_t i = 0; i < length; i++) {
+        const unsigned char c = (unsigned char)data[i];
+        if (c >= 0x20 && c != '\"' && c != '\\') {
+            continue;
+        }
+
+        if (i > start) {
+            jfes_status_t status = jfes_add_to_stringstream(stream, data + start, i - start);
+            if (jfes_status_is_bad(status)) {
+                return status;
+            }
+        }
+        start = i + 1;
+
+        char escape[6] = { '\\', (char)c, '0', '0', hex_digits[c >> 4], hex_digits[c & 0x0F] };
+        jfes_size_t escape_length = 2;
+        switch (c) {
+        case '\"': case '\\': break;
+        case '\b': escape[1] = 'b'; break;
+        case '\f': escape[1] = 'f'; break;
+        case '\n': escape[1] = 'n'; break;
+        case '\r': escape[1] = 'r'; break;
+        case '\t': escape[1] = 't'; break;
+        default:
+            escape[1] = 'u';
+            escape_length = 6;
+            break;
+        }
+
+        jfes_status_t status = jfes_add_to_stringstream(stream, escape, escape_length);
+        if (jfes_status_is_bad(status)) {
+            return status;
+        }
+    }
+
+    return length > start ? jfes_add_to_stringstream(stream, data + start, length - start) : jfes_success;
+}
+
+/**
+    Allocates a fresh unused token from the token pool.
+
+    \param[in, out] parser              Pointer to the jfes_parser_t object.
+    \param[in, out] tokens              Tokens array.
+    \param[in]      max_tokens          Maximal tokens count.
+
+    \return         Pointer to the allocated token from the token pool.
+*/
+static jfes_token_t *jfes_allocate_token(jfes_parser_t *parser, jfes_token_t *tokens, jfes_size_t max_tokens) {
+    if (!parser || !tokens || max_tokens == 0 || parser->next_token >= max_tokens) {
+        return JFES_NULL;
+    }
+    
+    jfes_token_t *token = &tokens[parser->next_token++];
+    token->start = token->end = -1;
+    token->size = 0;
+    token->parent = parser->superior_token;
+
+    return token;
+}
+
+/**
+    Finds the innermost container which is still open.
+
+    \param[in]      tokens              Tokens array.
+    \param[in]      index               Index of the token to start from.
+
+    \return         Index of the open container or -1 if there is no one.
+*/
+static int jfes_get_open_container(const jfes_token_t *tokens, int index) {
+    while (index != -1) {
+        const jfes_token_t *token = &tokens[index];
+        if ((token->type == jfes_type_array || token->type == jfes_type_object) && token->end == -1) {
+            break;
+        }
+        index = token->parent;
+    }
+
+    return index;
+}
+
+/**
+    Fills token type and boundaries.
+
+    \param[in, out] token               Pointer to the token to fill.
+    \param[in]      type                Token type.
+    \param[in]      start               Token boundary start.
+    \param[in]      end                 Token boundary end.
+*/
+static void jfes_fill_token(jfes_token_t *token, jfes_token_type_t type, int start, int end) {
+    if (token) {
+        token->type = type;
+        token->start = start;
+        token->end = end;
+        token->size = 0;
+    }
+}
+
+#ifdef JFES_USE_SIMD
+/**
+    Counts trailing zero bits.
+
+    \param[in]      mask                Non-zero mask.
+
+    \return         Index of the lowest set bit.
+*/
+static unsigned int jfes_count_trailing_zeros(unsigned long long mask) {
+#if defined(__GNUC__)
+    return (unsigned int)__builtin_ctzll(mask);
+#else
+    unsigned int count = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+    Classifies 64 bytes of JSON data into bitmasks. Bit `i` of each mask
+    describes `data[i]`.
+
+    \param[in]      data                64 bytes of JSON data.
+    \param[out]     whitespace_mask     Whitespace characters.
+    \param[out]     delimiter_mask      Characters that finish a primitive (including zero).
+*/
+static void jfes_classify_block(const char *data, unsigned long long *whitespace_mask,
+        unsigned long long *delimiter_mask) {
+    unsigned long long whitespace = 0;
+    unsigned long long delimiter = 0;
+
+#if defined(JFES_AVX2)
+    for (int i = 0; i < JFES_BLOCK_SIZE; i += 32) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+
+        __m256i ws = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+        __m256i dl = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(',')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(']'))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('}')), _mm256_cmpeq_epi8(v, _mm256_setzero_si256())));
+#ifndef JFES_STRICT
+        dl = _mm256_or_si256(dl, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(':')));
+#endif
+        dl = _mm256_or_si256(dl, ws);
+
+        whitespace |= (unsigned long long)(unsigned int)_mm256_movemask_epi8(ws) << i;
+        delimiter |= (unsigned long long)(unsigned int)_mm256_movemask_epi8(dl) << i;
+    }
+#elif defined(JFES_SSE2)
+    for (int i = 0; i < JFES_BLOCK_SIZE; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+
+        __m128i ws = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+        __m128i dl = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(',')), _mm_cmpeq_epi8(v, _mm_set1_epi8(']'))),
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('}')), _mm_cmpeq_epi8(v, _mm_setzero_si128())));
+#ifndef JFES_STRICT
+        dl = _mm_or_si128(dl, _mm_cmpeq_epi8(v, _mm_set1_epi8(':')));
+#endif
+        dl = _mm_or_si128(dl, ws);
+
+        whitespace |= (unsigned long long)_mm_movemask_epi8(ws) << i;
+        delimiter |= (unsigned long long)_mm_movemask_epi8(dl) << i;
+    }
+#else
+    for (int i = 0; i < JFES_BLOCK_SIZE; i++) {
+        const char c = data[i];
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            whitespace |= 1ull << i;
+            delimiter |= 1ull << i;
+        }
+        else if (c == ',' || c == ']' || c == '}' || c == '\0'
+#ifndef JFES_STRICT
+            || c == ':'
+#endif
+            ) {
+            delimiter |= 1ull << i;
+        }
+    }
+#endif
+
+    *whitespace_mask = whitespace;
+    *delimiter_mask = delimiter;
+}
+
+/**
+    Finds the next character in the string body that needs attention:
+    a quote, a backslash or zero. Checks 32 (AVX2) or 16 (SSE2) bytes at once.
+
+    \param[in]      json                JSON data string.
+    \param[in]      pos                 Position to start from.
+    \param[in]      length              JSON data length.
+
+    \return         Position of the found character or `length` if nothing was found.
+*/
+static jfes_size_t jfes_find_string_special(const char *json, jfes_size_t pos, jfes_size_t length) {
+#if defined(JFES_AVX2)
+    const __m256i quote = _mm256_set1_epi8('\"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i zero = _mm256_setzero_si256();
+    while (pos + 32 <= length) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(json + pos));
+        const unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+            _mm256_cmpeq_epi8(v, zero)));
+        if (mask) {
+            return pos + jfes_count_trailing_zeros(mask);
+        }
+        pos += 32;
+    }
+#elif defined(JFES_SSE2)
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i zero = _mm_setzero_si128();
+    while (pos + 16 <= length) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(json + pos));
+        const unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+            _mm_cmpeq_epi8(v, zero)));
+        if (mask) {
+            return pos + jfes_count_trailing_zeros(mask);
+        }
+        pos += 16;
+    }
+#endif
+
+    while (pos < length) {
+        const char c = json[pos];
+        if (c == '\"' || c == '\\' || c == '\0') {
+            return pos;
+        }
+        pos++;
+    }
+
+    return length;
+}
+
+/**
+    Finds the next whitespace or non-whitespace character by the bitmasks
+    of the classified blocks. Every block is classified only once.
+
+    \param[in, out] parser              Pointer to the jfes_parser_t object.
+    \param[in]      json                JSON data string.
+    \param[in]      length              JSON data length.
+    \param[in]      pos                 Position to start from.
+    \param[in]      delimiter           Non-zero to find the end of a primitive,
+                                        zero to find the end of whitespaces.
+
+    \return         Position of the found character or `length` if nothing was found.
+*/
+static jfes_size_t jfes_find_in_blocks(jfes_parser_t *parser, const char *json, jfes_size_t length,
+        jfes_size_t pos, int delimiter) {
+    while (pos < length) {
+        jfes_size_t block_start = pos - pos % JFES_BLOCK_SIZE;
+        if (parser->block_start != block_start) {
+            if (block_start + JFES_BLOCK_SIZE <= length) {
+                jfes_classify_block(json + block_start, &parser->whitespace_mask, &parser->delimiter_mask);
+            }
+            else {
+                char tail[JFES_BLOCK_SIZE] = { 0 };
+                jfes_memcpy(tail, json + block_start, length - block_start);
+                jfes_classify_block(tail, &parser->whitespace_mask, &parser->delimiter_mask);
+            }
+            parser->block_start = block_start;
+        }
+
+        unsigned long long mask = delimiter ? parser->delimiter_mask : ~parser->whitespace_mask;
+        mask >>= pos - block_start;
+        if (mask) {
+            pos += jfes_count_trailing_zeros(mask);
+            return pos < length ? pos : length;
+        }
+
+        pos = block_start + JFES_BLOCK_SIZE;
+    }
+
+    return length;
+}
+#endif
+
+#ifdef JFES_VALIDATE_UTF8
+#if defined(JFES_AVX2)
+/** Error bits of the UTF-8 lookup tables. Each bit marks a kind of invalid pair of bytes. */
+#define JFES_UTF8_TOO_SHORT             0x01    /**< Lead byte followed by a lead or ASCII byte. */
+#define JFES_UTF8_TOO_LONG              0x02    /**< ASCII byte followed by a continuation byte. */
+#define JFES_UTF8_OVERLONG_3            0x04    /**< 11100000 100_____ */
+#define JFES_UTF8_TOO_LARGE             0x08    /**< Code point above U+10FFFF. */
+#define JFES_UTF8_SURROGATE             0x10    /**< 11101101 101_____ */
+#define JFES_UTF8_OVERLONG_2            0x20    /**< 1100000_ 10______ */
+#define JFES_UTF8_TOO_LARGE_1000        0x40    /**< Code point above U+10FFFF, second byte 1000____. */
+#define JFES_UTF8_OVERLONG_4            0x40    /**< 11110000 1000____ */
+#define JFES_UTF8_TWO_CONTS             0x80    /**< Continuation byte after a continuation byte
+                                                     which doesn't need it. */
+
+/** Error bits which don't depend on the low nibble of the first byte. */
+#define JFES_UTF8_CARRY                 (JFES_UTF8_TOO_SHORT | JFES_UTF8_TOO_LONG | JFES_UTF8_TWO_CONTS)
+
+/**
+    Checks 32 bytes of UTF-8 data by lookup tables (Keiser and Lemire): every byte is
+    classified together with the previous one by three 16-entry tables, and bytes which
+    must be the third or fourth ones of a sequence are checked separately.
+
+    \param[in]      input               Current 32 bytes.
+    \param[in]      previous            Previous 32 bytes, zeros at the data start.
+
+    \return         Non-zero bytes where the data is invalid. The sequence that is not finished
+                    at the block end is checked with the next block.
+*/
+static __m256i jfes_check_utf8_block(__m256i input, __m256i previous) {
+    const __m256i byte_1_high_table = _mm256_setr_epi8(
+        JFES_UTF8_TOO_LONG, JFES_UTF8_TOO_LONG, JFES_UTF8_TOO_LONG, JFES_UTF8_TOO_LONG,
+        JFES_UTF8_TOO_LONG, JFES_UTF8_TOO_LONG, JFES_UTF8_TOO_LONG, JFES_UTF8_TOO_LONG,
+        (char)JFES_UTF8_TWO_CONTS, (char)JFES_UTF8_TWO_CONTS, (char)JFES_UTF8_TWO_CONTS, (char)JFES_UTF8_TWO_CONTS,
+        JFES_UTF8_TOO_SHORT | JFES_UTF8_OVERLONG_2,
+        JFES_UTF8_TOO_SHORT,
+        JFES_UTF8_TOO_SHORT | JFES_UTF8_OVERLONG_3 | JFES_UTF8_SURROGATE,
+        JFES_UTF8_TOO_SHORT | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000 | JFES_UTF8_OVERLONG_4,
+        JFES_UTF8_TOO_LONG, JFES_UTF8_TOO_LONG, JFES_UTF8_TOO_LONG, JFES_UTF8_TOO_LONG,
+        JFES_UTF8_TOO_LONG, JFES_UTF8_TOO_LONG, JFES_UTF8_TOO_LONG, JFES_UTF8_TOO_LONG,
+        (char)JFES_UTF8_TWO_CONTS, (char)JFES_UTF8_TWO_CONTS, (char)JFES_UTF8_TWO_CONTS, (char)JFES_UTF8_TWO_CONTS,
+        JFES_UTF8_TOO_SHORT | JFES_UTF8_OVERLONG_2,
+        JFES_UTF8_TOO_SHORT,
+        JFES_UTF8_TOO_SHORT | JFES_UTF8_OVERLONG_3 | JFES_UTF8_SURROGATE,
+        JFES_UTF8_TOO_SHORT | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000 | JFES_UTF8_OVERLONG_4);
+    const __m256i byte_1_low_table = _mm256_setr_epi8(
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_OVERLONG_3 | JFES_UTF8_OVERLONG_2 | JFES_UTF8_OVERLONG_4),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_OVERLONG_2),
+        (char)JFES_UTF8_CARRY, (char)JFES_UTF8_CARRY,
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000 | JFES_UTF8_SURROGATE),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_OVERLONG_3 | JFES_UTF8_OVERLONG_2 | JFES_UTF8_OVERLONG_4),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_OVERLONG_2),
+        (char)JFES_UTF8_CARRY, (char)JFES_UTF8_CARRY,
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000 | JFES_UTF8_SURROGATE),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000),
+        (char)(JFES_UTF8_CARRY | JFES_UTF8_TOO_LARGE | JFES_UTF8_TOO_LARGE_1000));
+    const __m256i byte_2_high_table = _mm256_setr_epi8(
+        JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT,
+        JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT,
+        (char)(JFES_UTF8_TOO_LONG | JFES_UTF8_OVERLONG_2 | JFES_UTF8_TWO_CONTS | JFES_UTF8_OVERLONG_3 |
+            JFES_UTF8_TOO_LARGE_1000 | JFES_UTF8_OVERLONG_4),
+        (char)(JFES_UTF8_TOO_LONG | JFES_UTF8_OVERLONG_2 | JFES_UTF8_TWO_CONTS | JFES_UTF8_OVERLONG_3 |
+            JFES_UTF8_TOO_LARGE),
+        (char)(JFES_UTF8_TOO_LONG | JFES_UTF8_OVERLONG_2 | JFES_UTF8_TWO_CONTS | JFES_UTF8_SURROGATE |
+            JFES_UTF8_TOO_LARGE),
+        (char)(JFES_UTF8_TOO_LONG | JFES_UTF8_OVERLONG_2 | JFES_UTF8_TWO_CONTS | JFES_UTF8_SURROGATE |
+            JFES_UTF8_TOO_LARGE),
+        JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT,
+        JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT,
+        JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT,
+        (char)(JFES_UTF8_TOO_LONG | JFES_UTF8_OVERLONG_2 | JFES_UTF8_TWO_CONTS | JFES_UTF8_OVERLONG_3 |
+            JFES_UTF8_TOO_LARGE_1000 | JFES_UTF8_OVERLONG_4),
+        (char)(JFES_UTF8_TOO_LONG | JFES_UTF8_OVERLONG_2 | JFES_UTF8_TWO_CONTS | JFES_UTF8_OVERLONG_3 |
+            JFES_UTF8_TOO_LARGE),
+        (char)(JFES_UTF8_TOO_LONG | JFES_UTF8_OVERLONG_2 | JFES_UTF8_TWO_CONTS | JFES_UTF8_SURROGATE |
+            JFES_UTF8_TOO_LARGE),
+        (char)(JFES_UTF8_TOO_LONG | JFES_UTF8_OVERLONG_2 | JFES_UTF8_TWO_CONTS | JFES_UTF8_SURROGATE |
+            JFES_UTF8_TOO_LARGE),
+        JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT, JFES_UTF8_TOO_SHORT);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+    /* Bytes 1, 2 and 3 positions back, the first ones come from the previous block. */
+    const __m256i shifted = _mm256_permute2x128_si256(previous, input, 0x21);
+    const __m256i previous_1 = _mm256_alignr_epi8(input, shifted, 15);
+    const __m256i previous_2 = _mm256_alignr_epi8(input, shifted, 14);
+    const __m256i previous_3 = _mm256_alignr_epi8(input, shifted, 13);
+
+    const __m256i byte_1_high = _mm256_shuffle_epi8(byte_1_high_table,
+        _mm256_and_si256(_mm256_srli_epi16(previous_1, 4), nibble));
+    const __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(previous_1, nibble));
+    const __m256i byte_2_high = _mm256_shuffle_epi8(byte_2_high_table,
+        _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+    const __m256i special_cases = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+    /* Continuation bytes after continuation bytes are fine only after 3 and 4 byte leads. */
+    const __m256i third_byte = _mm256_subs_epu8(previous_2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+    const __m256i fourth_byte = _mm256_subs_epu8(previous_3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+    const __m256i must_continue = _mm256_and_si256(_mm256_or_si256(third_byte, fourth_byte),
+        _mm256_set1_epi8((char)0x80));
+
+    return _mm256_xor_si256(must_continue, special_cases);
+}
+#endif
+
+/**
+    Checks that the data is valid UTF-8: no overlong forms, surrogates,
+    code points above U+10FFFF or unfinished sequences.
+
+    \param[in]      data                Data to check.
+    \param[in]      length              Data length.
+
+    \return         Non-zero if the data is valid.
+*/
+static int jfes_is_valid_utf8(const char *data, jfes_size_t length) {
+    jfes_size_t pos = 0;
+
+#if defined(JFES_AVX2)
+    /* Short strings are checked by the plain code: the block check costs more for them. */
+    if (length >= 32) {
+        __m256i previous = _mm256_setzero_si256();
+        __m256i error = _mm256_setzero_si256();
+        for (; pos + 32 <= length; pos += 32) {
+            const __m256i input = _mm256_loadu_si256((const __m256i*)(data + pos));
+            /* ASCII after ASCII needs no checks. */
+            if (_mm256_movemask_epi8(_mm256_or_si256(input, previous))) {
+                error = _mm256_or_si256(error, jfes_check_utf8_block(input, previous));
+            }
+            previous = input;
+        }
+
+        /* The tail is padded with zeros, so the sequence which is not finished fails. */
+        char tail[32] = { 0 };
+        jfes_memcpy(tail, data + pos, length - pos);
+        const __m256i input = _mm256_loadu_si256((const __m256i*)tail);
+        if (_mm256_movemask_epi8(_mm256_or_si256(input, previous))) {
+            error = _mm256_or_si256(error, jfes_check_utf8_block(input, previous));
+        }
+
+        return _mm256_testz_si256(error, error);
+    }
+#endif
+
+    const unsigned char *bytes = (const unsigned char*)data;
+    while (pos < length) {
+#if defined(JFES_SSE2)
+        while (pos + 16 <= length && !_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(data + pos)))) {
+            pos += 16;
+        }
+        if (pos >= length) {
+            break;
+        }
+#endif
+        const unsigned char c = bytes[pos];
+        if (c < 0x80) {
+            pos++;
+            continue;
+        }
+
+        jfes_size_t count = 0;
+        unsigned char min = 0x80;
+        unsigned char max = 0xBF;
+        if (c < 0xC2) {
+            return 0;
+        }
+        else if (c < 0xE0) {
+            count = 1;
+        }
+        else if (c < 0xF0) {
+            count = 2;
+            min = c == 0xE0 ? 0xA0 : 0x80;
+            max = c == 0xED ? 0x9F : 0xBF;
+        }
+        else if (c < 0xF5) {
+            count = 3;
+            min = c == 0xF0 ? 0x90 : 0x80;
+            max = c == 0xF4 ? 0x8F : 0xBF;
+        }
+        else {
+            return 0;
+        }
+
+        if (count >= length - pos || bytes[pos + 1] < min || bytes[pos + 1] > max) {
+            return 0;
+        }
+        for (jfes_size_t i = 2; i <= count; i++) {
+            if ((bytes[pos + i] & 0xC0) != 0x80) {
+                return 0;
+            }
+        }
+        pos += count + 1;
+    }
+
+    return 1;
+}
+#endif
+
+/**
+    Reads four hexadecimal digits of the `\u` escape sequence.
+
+    \param[in]      data                Digits.
+    \param[out]     code                Read code unit.
+
+    \return         Non-zero if all four characters are hexadecimal digits.
+*/
+static int jfes_read_code_unit(const char *data, unsigned long *code) {
+    *code = 0;
+    for (int i = 0; i < 4; i++) {
+        const int digit = jfes_hex_digit_value(data[i]);
+        if (digit < 0) {
+            return 0;
+        }
+        *code = (*code << 4) | (unsigned long)digit;
+    }
+
+    return 1;
+}
+
+/**
+    Writes the code point in UTF-8.
+
+    \param[out]     data                Output buffer. Must fit 4 bytes.
+    \param[in]      code                Code point up to U+10FFFF.
+
+    \return         Written bytes count.
+*/
+static jfes_size_t jfes_write_utf8(char *data, unsigned long code) {
+    if (code < 0x80) {
+        data[0] = (char)code;
+        return 1;
+    }
+    else if (code < 0x800) {
+        data[0] = (char)(0xC0 | (code >> 6));
+        data[1] = (char)(0x80 | (code & 0x3F));
+        return 2;
+    }
+    else if (code < 0x10000) {
+        data[0] = (char)(0xE0 | (code >> 12));
+        data[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        data[2] = (char)(0x80 | (code & 0x3F));
+        return 3;
+    }
+
+    data[0] = (char)(0xF0 | (code >> 18));
+    data[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+    data[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+    data[3] = (char)(0x80 | (code & 0x3F));
+    return 4;
+}
+
+/**
+    Reads the escape sequence at the backslash. Surrogate pairs are combined,
+    lone surrogates become U+FFFD. An invalid escape sequence is read as a single backslash.
+
+    \param[in]      string              String body without quotes.
+    \param[in]      length              String body length.
+    \param[in, out] pos                 Position of the backslash. Moved past the sequence.
+
+    \return         Code point of the sequence.
+*/
+static unsigned long jfes_read_escape(const char *string, jfes_size_t length, jfes_size_t *pos) {
+    const jfes_size_t start = *pos;
+    if (start + 1 >= length) {
+        *pos = start + 1;
+        return '\\';
+    }
+
+    *pos = start + 2;
+    switch (string[start + 1]) {
+    case 'b': return '\b';
+    case 'f': return '\f';
+    case 'n': return '\n';
+    case 'r': return '\r';
+    case 't': return '\t';
+    case '\"': return '\"';
+    case '/': return '/';
+    case '\\': return '\\';
+
+    case 'u':
+        {
+            unsigned long code = 0;
+            if (start + 6 > length || !jfes_read_code_unit(string + start + 2, &code)) {
+                break;
+            }
+            *pos = start + 6;
+
+            if (code >= 0xD800 && code <= 0xDBFF) {
+                unsigned long low = 0;
+                if (*pos + 6 <= length && string[*pos] == '\\' && string[*pos + 1] == 'u' &&
+                        jfes_read_code_unit(string + *pos + 2, &low) && low >= 0xDC00 && low <= 0xDFFF) {
+                    *pos += 6;
+                    return 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                }
+                return 0xFFFD;
+            }
+            else if (code >= 0xDC00 && code <= 0xDFFF) {
+                return 0xFFFD;
+            }
+            return code;
+        }
+
+    default:
+        break;
+    }
+
+    *pos = start + 1;
+    return '\\';
+}
+
+/**
+    Calculates the decoded length of the string body without decoding it.
+
+    \param[in]      string              String body without quotes.
+    \param[in]      length              String body length.
+
+    \return         Decoded string length, see jfes_decode_string.
+*/
+static jfes_size_t jfes_decoded_length(const char *string, jfes_size_t length) {
+    jfes_size_t pos = 0;
+    jfes_size_t size = 0;
+    char sequence[4];
+
+    while (pos < length) {
+        if (string[pos] != '\\') {
+            pos++;
+            size++;
+        }
+        else {
+            size += jfes_write_utf8(sequence, jfes_read_escape(string, length, &pos));
+        }
+    }
+
+    return size;
+}
+
+/**
+    Copies the string body and decodes its escape sequences. Surrogate pairs become
+    one UTF-8 sequence, lone surrogates become U+FFFD. Invalid escape sequences are copied as is.
+    The decoded string is never longer than the source one.
+
+    \param[out]     data                Output buffer of `length` bytes at least.
+    \param[in]      string              String body without quotes.
+    \param[in]      length              String body length.
+
+    \return         Decoded string length.
+*/
+static jfes_size_t jfes_decode_string(char *data, const char *string, jfes_size_t length) {
+    jfes_size_t pos = 0;
+    jfes_size_t size = 0;
+
+    while (pos < length) {
+        /* Copy the run before the next backslash. Only the blocks without a backslash are stored,
+           so the output never outruns the unread input and the string can be decoded in place. */
+#if defined(JFES_AVX2)
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        while (pos + 32 <= length) {
+            const __m256i v = _mm256_loadu_si256((const __m256i*)(string + pos));
+            const unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, backslash));
+            if (mask) {
+                break;
+            }
+            _mm256_storeu_si256((__m256i*)(data + size), v);
+            pos += 32;
+            size += 32;
+        }
+#elif defined(JFES_SSE2)
+        const __m128i backslash = _mm_set1_epi8('\\');
+        while (pos + 16 <= length) {
+            const __m128i v = _mm_loadu_si128((const __m128i*)(string + pos));
+            const unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, backslash));
+            if (mask) {
+                break;
+            }
+            _mm_storeu_si128((__m128i*)(data + size), v);
+            pos += 16;
+            size += 16;
+        }
+#endif
+        while (pos < length && string[pos] != '\\') {
+            data[size++] = string[pos++];
+        }
+
+        if (pos < length) {
+            size += jfes_write_utf8(data + size, jfes_read_escape(string, length, &pos));
+        }
+    }
+
+    return size;
+}
+
+/**
+    Creates string object from the JSON string body: escape sequences are decoded.
+    `size` of the created string is its decoded length plus one.
+
+    \param[in]      config              JFES configuration.
+    \param[out]     str                 String to be created.
+    \param[in]      string              JSON string body without quotes.
+    \param[in]      length              JSON string body length.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_create_decoded_string(const jfes_config_t *config, jfes_string_t *str,
+        const char *string, jfes_size_t length) {
+    if (!string) {
+        return jfes_invalid_arguments;
+    }
+
+    const jfes_status_t status = jfes_allocate_string(config, str, length + 1);
+    if (jfes_status_is_good(status)) {
+        const jfes_size_t size = jfes_decode_string(str->data, string, length);
+        str->data[size] = '\0';
+        str->size = size + 1;
+    }
+
+    return status;
+}
+
+/**
+    Creates string object from the string token. If the JSON data is parsed in situ,
+    the token is decoded in place and the string points into the JSON data.
+
+    \param[in]      tokens_data         Pointer to the jfes_tokens_data_t object.
+    \param[in, out] in_situ_data        Writable JSON data for the in-situ strings or JFES_NULL.
+    \param[out]     str                 String to be created.
+    \param[in]      token               String token.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_create_token_string(const jfes_tokens_data_t *tokens_data, char *in_situ_data,
+        jfes_string_t *str, const jfes_token_t *token) {
+    const jfes_size_t length = (jfes_size_t)(token->end - token->start);
+
+    /* The terminating zero replaces the character after the token, so it must be inside the data. */
+    if (!in_situ_data || (jfes_size_t)token->end >= tokens_data->json_data_length) {
+        return jfes_create_decoded_string(tokens_data->config, str,
+            tokens_data->json_data + token->start, length);
+    }
+
+    char *data = in_situ_data + token->start;
+    const jfes_size_t size = jfes_decode_string(data, data, length);
+    data[size] = '\0';
+
+    str->data = data;
+    str->size = size + 1;
+    str->borrowed = 1;
+    return jfes_success;
+}
+
+/**
+    Fills next available token with JSON primitive.
+
+    \param[in, out] parser              Pointer to the jfes_parser_t object.
+    \param[in]      json                JSON data string.
+    \param[in]      length              JSON data length.
+    \param[out]     tokens              Tokens array to fill.
+    \param[in]      max_tokens_count    Maximal count of tokens in tokens array.
+    \param[in]      partial             Non-zero if more data can follow, so the primitive
+                                        that reaches the end of data is not finished yet.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_parse_primitive(jfes_parser_t *parser, const char *json, jfes_size_t length,
+        jfes_token_t *tokens, jfes_size_t max_tokens_count, int partial) {
+    if (!parser || !json || length == 0 || !tokens || max_tokens_count == 0) {
+        return jfes_invalid_arguments;
+    }
+
+    int found = 0;
+
+    jfes_size_t start = parser->pos;
+    if (parser->part_end > parser->pos) {
+        parser->pos = parser->part_end;
+    }
+
+#ifdef JFES_USE_SIMD
+    parser->pos = jfes_find_in_blocks(parser, json, length, parser->pos, 1);
+    found = parser->pos < length && json[parser->pos] != '\0';
+#else
+    while (parser->pos < length && json[parser->pos] != '\0') {
+        char c = json[parser->pos];
+        if (c == '\t' || c == '\n' || c == '\r' || c == ' ' ||
+            c == ',' || c == ']' || c == '}'
+#ifndef JFES_STRICT
+            || c == ':'
+#endif
+            ) {
+            found = 1;
+            break;
+        }
+
+        parser->pos++;
+    }
+#endif
+
+#ifdef JFES_STRICT
+    partial = 1;
+#endif
+
+    if (!found && partial) {
+        parser->part_end = parser->pos;
+        parser->pos = start;
+        return jfes_error_part;
+    }
+
+    jfes_token_t *token = jfes_allocate_token(parser, tokens, max_tokens_count);
+    if (!token) {
+        parser->pos = start;
+        return jfes_no_memory;
+    }
+
+    jfes_size_t token_length = parser->pos - start;
+#ifdef JFES_TOKEN_VALUES
+    jfes_token_type_t type = jfes_read_primitive(json + start, token_length, &token->value);
+#else
+    jfes_token_type_t type = jfes_read_primitive(json + start, token_length, JFES_NULL);
+#endif
+
+    jfes_fill_token(token, type, start, parser->pos);
+    parser->pos--;
+
+    return jfes_success;
+}
+
+/**
+    Fills next available token with JSON string.
+
+    \param[in, out] parser              Pointer to the jfes_parser_t object.
+    \param[in]      json                JSON data string.
+    \param[in]      length              JSON data length.
+    \param[out]     tokens              Tokens array to fill.
+    \param[in]      max_tokens_count    Maximal count of tokens in tokens array.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_parse_string(jfes_parser_t *parser, const char *json, jfes_size_t length,
+        jfes_token_t *tokens, jfes_size_t max_tokens_count) {
+    if (!parser || !json || length == 0 || !tokens || max_tokens_count == 0) {
+        return jfes_invalid_arguments;
+    }
+
+    jfes_size_t start = parser->pos++;
+    if (parser->part_end > parser->pos) {
+        parser->pos = parser->part_end;
+    }
+
+    jfes_size_t element = parser->pos;
+    while (parser->pos < length && json[parser->pos] != '\0') {
+#ifdef JFES_USE_SIMD
+        parser->pos = jfes_find_string_special(json, parser->pos, length);
+        if (parser->pos >= length || json[parser->pos] == '\0') {
+            element = parser->pos;
+            break;
+        }
+#endif
+        element = parser->pos;
+
+        char c = json[parser->pos];
+        if (c == '\"') {
+#ifdef JFES_VALIDATE_UTF8
+            if (!jfes_is_valid_utf8(json + start + 1, parser->pos - start - 1)) {
+                parser->pos = start;
+                return jfes_invalid_input;
+            }
+#endif
+            jfes_token_t *token = jfes_allocate_token(parser, tokens, max_tokens_count);
+            if (!token) {
+                parser->pos = start;
+                return jfes_no_memory;
+            }
+
+            jfes_fill_token(token, jfes_type_string, start + 1, parser->pos);
+            return jfes_success;
+        }
+        else if (c == '\\' && parser->pos + 1 < length) {
+            parser->pos++;
+            switch (json[parser->pos]) {
+            case '\"': case '/': case '\\': case 'b': case 'f':
+            case 'r': case 'n': case 't':
+                break;
+
+            case 'u':
+                parser->pos++;
+                for (jfes_size_t i = 0;  i < 4 && parser->pos < length && json[parser->pos] != '\0'; i++, parser->pos++) {
+                    char symbol = json[parser->pos];
+                    if ((symbol < (int)'0' || symbol > (int)'9') &&
+                        (symbol < (int)'A' || symbol > (int)'F') &&
+                        (symbol < (int)'a' || symbol > (int)'f')) {
+                        parser->pos = start;
+                        return jfes_invalid_input;
+                    }
+                }
+                parser->pos--;
+                break;
+            default:
+                parser->pos = start;
+                return jfes_invalid_input;
+            }
+        }
+        parser->pos++;
+    }
+
+    /* The last character or escape sequence may be incomplete, so it will be scanned again. */
+    parser->part_end = element;
+    parser->pos = start;
+    return jfes_error_part;
+}
+
+int jfes_status_is_good(jfes_status_t status) {
+    return status == jfes_success;
+}
+
+int jfes_status_is_bad(jfes_status_t status) {
+    return !jfes_status_is_good(status);
+}
+
+jfes_status_t jfes_init_parser(jfes_parser_t *parser, const jfes_config_t *config) {
+    if (!parser || !config) {
+        return jfes_invalid_arguments;
+    }
+
+    parser->config = config;
+
+    return jfes_reset_parser(parser);
+}
+
+jfes_status_t jfes_reset_parser(jfes_parser_t *parser) {
+    if (!parser) {
+        return jfes_invalid_arguments;
+    }
+
+    parser->pos = 0;
+    parser->next_token = 0;
+    parser->superior_token = -1;
+    parser->part_end = 0;
+
+    return jfes_success;
+}
+
+/**
+    Parses JSON data string into tokens starting from the current parser state.
+
+    \param[in, out] parser              Pointer to the jfes_parser_t object.
+    \param[in]      json                JSON data string.
+    \param[in]      length              JSON data length.
+    \param[out]     tokens              Tokens array to fill.
+    \param[in, out] max_tokens_count    Maximal count of tokens in tokens array.
+                                        Will contain tokens count.
+    \param[in]      partial             Non-zero if more data can follow.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_parse_tokens_helper(jfes_parser_t *parser, const char *json,
+        jfes_size_t length, jfes_token_t *tokens, jfes_size_t *max_tokens_count, int partial) {
+    jfes_token_t *token = JFES_NULL;
+
+#ifdef JFES_USE_SIMD
+    /* Data could be changed since the last call. 1 is never a block start. */
+    parser->block_start = 1;
+#endif
+
+    jfes_size_t count = parser->next_token;
+    while (parser->pos < length && json[parser->pos] != '\0') {
+        char c = json[parser->pos];
+        switch (c) {
+        case '{': case '[':
+            {
+                count++;
+                token = jfes_allocate_token(parser, tokens, *max_tokens_count);
+                if (!token) {
+                    return jfes_no_memory;
+                }
+                if (parser->superior_token != -1) {
+                    tokens[parser->superior_token].size++;
+                }
+
+                token->type = (c == '{' ? jfes_type_object : jfes_type_array);
+                token->start = parser->pos;
+                parser->superior_token = parser->next_token - 1;
+            }
+            break;
+
+        case '}': case ']':
+            {
+                int i = jfes_get_open_container(tokens, parser->superior_token);
+                if (i == -1) {
+                    return jfes_invalid_input;
+                }
+
+                tokens[i].end = parser->pos + 1;
+                parser->superior_token = jfes_get_open_container(tokens, tokens[i].parent);
+            }
+            break;
+
+        case '\"':
+            {
+                jfes_status_t status = jfes_parse_string(parser, json, length, tokens, *max_tokens_count);
+                if (jfes_status_is_bad(status)) {
+                    return status;
+                }
+
+                count++;
+
+                if (parser->superior_token != -1 && tokens != JFES_NULL) {
+                    tokens[parser->superior_token].size++;
+                }
+            }
+            break;
+
+        case '\t': case '\r': case '\n': case ' ':
+#ifdef JFES_USE_SIMD
+            parser->pos = jfes_find_in_blocks(parser, json, length, parser->pos, 0) - 1;
+#endif
+            break;
+
+        case ':':
+            parser->superior_token = parser->next_token - 1;
+            break;
+
+        case ',':
+            {
+                if (parser->superior_token != -1 &&
+                    tokens[parser->superior_token].type != jfes_type_array &&
+                    tokens[parser->superior_token].type != jfes_type_object) {
+                    parser->superior_token = jfes_get_open_container(tokens, tokens[parser->superior_token].parent);
+                }
+            }
+            break;
+
+#ifdef JFES_STRICT
+        case '-': case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+        case 't': case 'f': case 'n':
+            if (parser->superior_token != -1) {
+                jfes_token_t *token = &tokens[parser->superior_token];
+                if (token->type == jfes_type_object || (token->type == jfes_type_string && token->size != 0)) {
+                    return jfes_invalid_input;
+                }
+            }
+#else
+        default:
+#endif
+            {
+                jfes_status_t status = jfes_parse_primitive(parser, json, length, tokens, *max_tokens_count, partial);
+                if (jfes_status_is_bad(status)) {
+                    return status;
+                }
+
+                count++;
+                if (parser->superior_token != -1) {
+                    tokens[parser->superior_token].size++;
+                }
+            }
+            break;
+#ifdef JFES_STRICT
+        default:
+            return jfes_invalid_input;
+#endif
+        }
+        parser->pos++;
+    }
+
+    if (jfes_get_open_container(tokens, parser->superior_token) != -1) {
+        return jfes_error_part;
+    }
+
+    *max_tokens_count = count;
+    return jfes_success;
+}
+
+jfes_status_t jfes_parse_tokens(jfes_parser_t *parser, const char *json,
+        jfes_size_t length, jfes_token_t *tokens, jfes_size_t *max_tokens_count) {
+    if (!parser || !json || length == 0 || !tokens || !max_tokens_count || *max_tokens_count == 0) {
+        return jfes_invalid_arguments;
+    }
+
+    jfes_reset_parser(parser);
+
+    return jfes_parse_tokens_helper(parser, json, length, tokens, max_tokens_count, 0);
+}
+
+jfes_status_t jfes_continue_parse_tokens(jfes_parser_t *parser, const char *json,
+        jfes_size_t length, jfes_token_t *tokens, jfes_size_t *max_tokens_count) {
+    if (!parser || !json || length == 0 || !tokens || !max_tokens_count || *max_tokens_count == 0) {
+        return jfes_invalid_arguments;
+    }
+
+    return jfes_parse_tokens_helper(parser, json, length, tokens, max_tokens_count, 1);
+}
+
+#ifdef JFES_USE_THREADS
+/** Superior token of the chunk which is out of the chunk: open container at the given depth above the chunk start. */
+#define JFES_EXTERNAL_TOKEN(depth)      (-2 - (int)(depth))
+
+/** Depth of the external superior token. */
+#define JFES_EXTERNAL_DEPTH(index)      ((jfes_size_t)(-2 - (index)))
+
+/** Data of the external container touched by the chunk. */
+typedef struct jfes_chunk_external {
+    int                     size;               /**< Count of the chunk tokens which are direct children of the container. */
+    int                     end;                /**< End of the container if the chunk closes it. */
+    int                     index;              /**< Global index of the container or -1. Filled by the stitching. */
+} jfes_chunk_external_t;
+
+/** Part of the JSON data parsed by the one thread. */
+typedef struct jfes_chunk {
+    const jfes_config_t     *config;            /**< JFES configuration. */
+    const char              *json;              /**< JSON data string. */
+    jfes_size_t             start;              /**< Chunk start. Only first pass: nominal start. */
+    jfes_size_t             end;                /**< Chunk end. Only first pass: nominal end. */
+    int                     last;               /**< Non-zero if this is the last chunk. */
+    jfes_size_t             quotes;             /**< Count of the unescaped quotes between nominal start and end. */
+
+    jfes_token_t            *tokens;            /**< Chunk tokens. Parents are local or external. */
+    jfes_size_t             tokens_count;       /**< Chunk tokens count. */
+    jfes_size_t             tokens_capacity;    /**< Allocated tokens count. */
+
+    jfes_chunk_external_t   *externals;         /**< External containers by depth. */
+    jfes_size_t             depth;              /**< Count of the closed external containers. */
+    jfes_size_t             externals_capacity; /**< Allocated external containers count. */
+
+    int                     superior_token;     /**< Superior token at the chunk end. */
+    jfes_size_t             offset;             /**< Index of the first chunk token in the result. */
+    jfes_token_t            *result;            /**< Resulting tokens array. */
+    jfes_status_t           status;             /**< Chunk parsing status. */
+} jfes_chunk_t;
+
+/**
+    Counts unescaped quotes of the chunk. Backslashes are valid only inside strings,
+    so a backslash always escapes the next character.
+
+    \param[in, out] argument            Pointer to the jfes_chunk_t object.
+
+    \return         JFES_NULL.
+*/
+static void *jfes_count_chunk_quotes(void *argument) {
+    jfes_chunk_t *chunk = (jfes_chunk_t*)argument;
+    const char *json = chunk->json;
+
+    jfes_size_t pos = chunk->start;
+
+    /* The first character can be escaped by the backslashes of the previous chunk. */
+    jfes_size_t backslashes = 0;
+    while (backslashes < pos && json[pos - backslashes - 1] == '\\') {
+        backslashes++;
+    }
+    pos += backslashes % 2;
+
+    jfes_size_t quotes = 0;
+    for (; pos < chunk->end; pos++) {
+        if (json[pos] == '\\') {
+            pos++;
+        }
+        else if (json[pos] == '\"') {
+            quotes++;
+        }
+    }
+
+    chunk->quotes = quotes;
+    return JFES_NULL;
+}
+
+/**
+    Finds the chunk start: the first position after a comma which is out of strings.
+
+    \param[in]      json                JSON data string.
+    \param[in]      pos                 Nominal chunk start.
+    \param[in]      end                 Start of the next chunk.
+    \param[in]      in_string           Non-zero if the nominal start is inside a string.
+
+    \return         Chunk start or `end` if there are no suitable commas, so the chunk is empty.
+*/
+static jfes_size_t jfes_find_chunk_start(const char *json, jfes_size_t pos, jfes_size_t end, int in_string) {
+    jfes_size_t backslashes = 0;
+    while (backslashes < pos && json[pos - backslashes - 1] == '\\') {
+        backslashes++;
+    }
+    pos += backslashes % 2;
+
+    for (; pos < end; pos++) {
+        const char c = json[pos];
+        if (c == '\\') {
+            pos++;
+        }
+        else if (c == '\"') {
+            in_string = !in_string;
+        }
+        else if (c == ',' && !in_string) {
+            return pos + 1;
+        }
+    }
+
+    return end;
+}
+
+/**
+    Grows the chunk tokens array twice.
+
+    \param[in, out] chunk               Pointer to the jfes_chunk_t object.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_grow_chunk_tokens(jfes_chunk_t *chunk) {
+    /* The first chunk is parsed right into the resulting array. */
+    if (chunk->tokens == chunk->result) {
+        return jfes_no_memory;
+    }
+
+    const jfes_size_t capacity = chunk->tokens_capacity * 2;
+    jfes_token_t *tokens = chunk->config->jfes_malloc(capacity * sizeof(jfes_token_t));
+    if (!tokens) {
+        return jfes_no_memory;
+    }
+
+    jfes_memcpy(tokens, chunk->tokens, chunk->tokens_count * sizeof(jfes_token_t));
+    chunk->config->jfes_free(chunk->tokens);
+
+    chunk->tokens = tokens;
+    chunk->tokens_capacity = capacity;
+    return jfes_success;
+}
+
+/**
+    Returns the external container of the chunk, allocating it if needed.
+
+    \param[in, out] chunk               Pointer to the jfes_chunk_t object.
+    \param[in]      depth               Depth of the external container.
+
+    \return         External container or JFES_NULL if there is no memory.
+*/
+static jfes_chunk_external_t *jfes_get_chunk_external(jfes_chunk_t *chunk, jfes_size_t depth) {
+    if (depth >= chunk->externals_capacity) {
+        const jfes_size_t capacity = chunk->externals_capacity * 2 > depth ? chunk->externals_capacity * 2 : depth + 1;
+        jfes_chunk_external_t *externals = chunk->config->jfes_malloc(capacity * sizeof(jfes_chunk_external_t));
+        if (!externals) {
+            return JFES_NULL;
+        }
+
+        jfes_memcpy(externals, chunk->externals, chunk->externals_capacity * sizeof(jfes_chunk_external_t));
+        for (jfes_size_t i = chunk->externals_capacity; i < capacity; i++) {
+            externals[i].size = 0;
+            externals[i].end = -1;
+            externals[i].index = -1;
+        }
+
+        if (chunk->externals) {
+            chunk->config->jfes_free(chunk->externals);
+        }
+        chunk->externals = externals;
+        chunk->externals_capacity = capacity;
+    }
+
+    return &chunk->externals[depth];
+}
+
+/**
+    Finds the innermost open container of the chunk. The containers out of the chunk
+    are never reopened, so the walk out of the chunk always ends at the current depth.
+
+    \param[in]      chunk               Pointer to the jfes_chunk_t object.
+    \param[in]      index               Index of the token to start from.
+
+    \return         Index of the open container: local or external.
+*/
+static int jfes_get_chunk_open_container(const jfes_chunk_t *chunk, int index) {
+    while (index >= 0) {
+        const jfes_token_t *token = &chunk->tokens[index];
+        if ((token->type == jfes_type_array || token->type == jfes_type_object) && token->end == -1) {
+            return index;
+        }
+        index = token->parent;
+    }
+
+    return JFES_EXTERNAL_TOKEN(chunk->depth);
+}
+
+/**
+    Parses the chunk into its own tokens array. The rules are the same as in
+    jfes_parse_tokens_helper, but the tokens out of the chunk are unknown: they are
+    referenced by depth and resolved by jfes_stitch_chunks.
+
+    \param[in, out] argument            Pointer to the jfes_chunk_t object.
+
+    \return         JFES_NULL.
+*/
+static void *jfes_parse_chunk(void *argument) {
+    jfes_chunk_t *chunk = (jfes_chunk_t*)argument;
+    const char *json = chunk->json;
+    const jfes_size_t length = chunk->end;
+
+    jfes_parser_t parser;
+    jfes_init_parser(&parser, chunk->config);
+    parser.pos = chunk->start;
+    parser.superior_token = JFES_EXTERNAL_TOKEN(0);
+
+#ifdef JFES_USE_SIMD
+    parser.block_start = 1;
+#endif
+
+    chunk->status = jfes_invalid_input;
+    if (!jfes_get_chunk_external(chunk, 0)) {
+        chunk->status = jfes_no_memory;
+        return JFES_NULL;
+    }
+
+    jfes_size_t last_comma = length;
+    while (parser.pos < length) {
+        const char c = json[parser.pos];
+        int new_token = 0;
+
+        chunk->tokens_count = parser.next_token;
+        if (chunk->tokens_count >= chunk->tokens_capacity && jfes_status_is_bad(jfes_grow_chunk_tokens(chunk))) {
+            chunk->status = jfes_no_memory;
+            return JFES_NULL;
+        }
+
+        switch (c) {
+        case '{': case '[':
+            {
+                jfes_token_t *token = jfes_allocate_token(&parser, chunk->tokens, chunk->tokens_capacity);
+                token->type = (c == '{' ? jfes_type_object : jfes_type_array);
+                token->start = parser.pos;
+                new_token = 1;
+            }
+            break;
+
+        case '}': case ']':
+            {
+                const int i = jfes_get_chunk_open_container(chunk, parser.superior_token);
+                if (i >= 0) {
+                    chunk->tokens[i].end = parser.pos + 1;
+                    parser.superior_token = jfes_get_chunk_open_container(chunk, chunk->tokens[i].parent);
+                }
+                else {
+                    chunk->externals[chunk->depth].end = parser.pos + 1;
+                    chunk->depth++;
+                    parser.superior_token = JFES_EXTERNAL_TOKEN(chunk->depth);
+                    if (!jfes_get_chunk_external(chunk, chunk->depth)) {
+                        chunk->status = jfes_no_memory;
+                        return JFES_NULL;
+                    }
+                }
+            }
+            break;
+
+        case '\"':
+            if (jfes_status_is_bad(jfes_parse_string(&parser, json, length, chunk->tokens, chunk->tokens_capacity))) {
+                return JFES_NULL;
+            }
+            new_token = 1;
+            break;
+
+        case '\t': case '\r': case '\n': case ' ':
+#ifdef JFES_USE_SIMD
+            parser.pos = jfes_find_in_blocks(&parser, json, length, parser.pos, 0) - 1;
+#endif
+            break;
+
+        case ':':
+            /* The key is in the previous chunk. */
+            if (parser.next_token == 0) {
+                return JFES_NULL;
+            }
+            parser.superior_token = parser.next_token - 1;
+            break;
+
+        case ',':
+            if (parser.superior_token >= 0 &&
+                chunk->tokens[parser.superior_token].type != jfes_type_array &&
+                chunk->tokens[parser.superior_token].type != jfes_type_object) {
+                parser.superior_token = jfes_get_chunk_open_container(chunk, chunk->tokens[parser.superior_token].parent);
+            }
+            last_comma = parser.pos;
+            break;
+
+        case '\0':
+            return JFES_NULL;
+
+        default:
+            if (jfes_status_is_bad(jfes_parse_primitive(&parser, json, length, chunk->tokens, chunk->tokens_capacity, 0))) {
+                return JFES_NULL;
+            }
+            new_token = 1;
+            break;
+        }
+
+        if (new_token) {
+            if (parser.superior_token >= 0) {
+                chunk->tokens[parser.superior_token].size++;
+            }
+            else {
+                chunk->externals[JFES_EXTERNAL_DEPTH(parser.superior_token)].size++;
+            }
+
+            if (c == '{' || c == '[') {
+                parser.superior_token = parser.next_token - 1;
+            }
+        }
+
+        parser.pos++;
+    }
+
+    /* The next chunk expects to start right after a comma inside the innermost open container. */
+    if (!chunk->last && (last_comma + 1 != length ||
+        parser.superior_token != jfes_get_chunk_open_container(chunk, parser.superior_token))) {
+        return JFES_NULL;
+    }
+
+    chunk->tokens_count = parser.next_token;
+    chunk->superior_token = parser.superior_token;
+    chunk->status = jfes_success;
+    return JFES_NULL;
+}
+
+/**
+    Copies the chunk tokens to the resulting array and resolves their parents.
+    Tokens of the first chunk are already in place.
+
+    \param[in, out] argument            Pointer to the jfes_chunk_t object.
+
+    \return         JFES_NULL.
+*/
+static void *jfes_copy_chunk_tokens(void *argument) {
+    jfes_chunk_t *chunk = (jfes_chunk_t*)argument;
+
+    jfes_token_t *result = chunk->result + chunk->offset;
+    for (jfes_size_t i = 0; i < chunk->tokens_count; i++) {
+        result[i] = chunk->tokens[i];
+
+        const int parent = chunk->tokens[i].parent;
+        result[i].parent = parent >= 0 ? parent + (int)chunk->offset : chunk->externals[JFES_EXTERNAL_DEPTH(parent)].index;
+    }
+
+    return JFES_NULL;
+}
+
+/**
+    Runs the function for every chunk, each one in its own thread.
+    The first chunk is processed in the calling thread.
+
+    \param[in]      function            Thread function.
+    \param[in, out] chunks              Chunks array.
+    \param[in]      chunks_count        Chunks count.
+*/
+static void jfes_run_chunks(void *(*function)(void*), jfes_chunk_t *chunks, jfes_size_t chunks_count) {
+    pthread_t threads[JFES_MAX_THREADS];
+    int started[JFES_MAX_THREADS];
+
+    for (jfes_size_t i = 1; i < chunks_count; i++) {
+        started[i] = pthread_create(&threads[i], JFES_NULL, function, &chunks[i]) == 0;
+        if (!started[i]) {
+            function(&chunks[i]);
+        }
+    }
+
+    function(&chunks[0]);
+
+    for (jfes_size_t i = 1; i < chunks_count; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], JFES_NULL);
+        }
+    }
+}
+
+/**
+    Resolves the chunk references to each other: computes token offsets and finds
+    the external containers of every chunk with the stack of open containers.
+
+    \param[in]      config              JFES configuration.
+    \param[in, out] chunks              Parsed chunks.
+    \param[in]      chunks_count        Chunks count.
+    \param[in]      max_tokens_count    Maximal count of tokens in the resulting array.
+    \param[out]     superior_token      Superior token at the end of data.
+
+    \return         Tokens count or zero if the chunks can't be stitched and
+                    the data must be parsed sequentially.
+*/
+static jfes_size_t jfes_stitch_chunks(const jfes_config_t *config, jfes_chunk_t *chunks,
+        jfes_size_t chunks_count, jfes_size_t max_tokens_count, int *superior_token) {
+    jfes_size_t stack_capacity = 64;
+    jfes_size_t stack_count = 0;
+    int *stack = config->jfes_malloc(stack_capacity * sizeof(int));
+    if (!stack) {
+        return 0;
+    }
+
+    jfes_size_t offset = 0;
+    for (jfes_size_t i = 0; i < chunks_count; i++) {
+        jfes_chunk_t *chunk = &chunks[i];
+        if (jfes_status_is_bad(chunk->status) || chunk->depth > stack_count
+            || chunk->tokens_count > max_tokens_count - offset) {
+            config->jfes_free(stack);
+            return 0;
+        }
+
+        chunk->offset = offset;
+        offset += chunk->tokens_count;
+
+        for (jfes_size_t depth = 0; depth <= chunk->depth; depth++) {
+            chunk->externals[depth].index = depth < stack_count ? stack[stack_count - depth - 1] : -1;
+        }
+        stack_count -= chunk->depth;
+
+        /* Open containers of the chunk, from the innermost one. */
+        jfes_size_t pushed = stack_count;
+        for (int index = chunk->superior_token; index >= 0; index = chunk->tokens[index].parent) {
+            const jfes_token_t *token = &chunk->tokens[index];
+            if ((token->type != jfes_type_array && token->type != jfes_type_object) || token->end != -1) {
+                continue;
+            }
+
+            if (stack_count >= stack_capacity) {
+                int *new_stack = config->jfes_malloc(stack_capacity * 2 * sizeof(int));
+                if (!new_stack) {
+                    config->jfes_free(stack);
+                    return 0;
+                }
+
+                jfes_memcpy(new_stack, stack, stack_count * sizeof(int));
+                config->jfes_free(stack);
+                stack = new_stack;
+                stack_capacity *= 2;
+            }
+            stack[stack_count++] = index + (int)chunk->offset;
+        }
+
+        for (jfes_size_t left = pushed, right = stack_count; left + 1 < right; left++, right--) {
+            const int index = stack[left];
+            stack[left] = stack[right - 1];
+            stack[right - 1] = index;
+        }
+    }
+
+    config->jfes_free(stack);
+
+    /* Unclosed containers: leave the error to the sequential parser. */
+    if (stack_count != 0) {
+        return 0;
+    }
+
+    const jfes_chunk_t *last = &chunks[chunks_count - 1];
+    *superior_token = last->superior_token >= 0 ? last->superior_token + (int)last->offset
+        : last->externals[JFES_EXTERNAL_DEPTH(last->superior_token)].index;
+
+    return offset;
+}
+
+/**
+    Frees memory of the chunks.
+
+    \param[in]      config              JFES configuration.
+    \param[in, out] chunks              Chunks array.
+    \param[in]      chunks_count        Chunks count.
+*/
+static void jfes_free_chunks(const jfes_config_t *config, jfes_chunk_t *chunks, jfes_size_t chunks_count) {
+    for (jfes_size_t i = 0; i < chunks_count; i++) {
+        if (chunks[i].tokens && chunks[i].tokens != chunks[i].result) {
+            config->jfes_free(chunks[i].tokens);
+        }
+        if (chunks[i].externals) {
+            config->jfes_free(chunks[i].externals);
+        }
+    }
+}
+
+jfes_status_t jfes_parse_tokens_parallel(jfes_parser_t *parser, const char *json, jfes_size_t length,
+        jfes_token_t *tokens, jfes_size_t *max_tokens_count, jfes_size_t threads_count) {
+    if (!parser || !json || length == 0 || !tokens || !max_tokens_count || *max_tokens_count == 0) {
+        return jfes_invalid_arguments;
+    }
+
+    if (threads_count > JFES_MAX_THREADS) {
+        threads_count = JFES_MAX_THREADS;
+    }
+    if (threads_count > length / JFES_MIN_CHUNK_SIZE) {
+        threads_count = length / JFES_MIN_CHUNK_SIZE;
+    }
+
+#ifdef JFES_STRICT
+    /* Strict rules need the types of the containers out of the chunk. */
+    threads_count = 1;
+#endif
+
+    if (threads_count <= 1 || !jfes_check_configuration(parser->config)) {
+        return jfes_parse_tokens(parser, json, length, tokens, max_tokens_count);
+    }
+
+    const jfes_config_t *config = parser->config;
+
+    jfes_chunk_t chunks[JFES_MAX_THREADS];
+    for (jfes_size_t i = 0; i < threads_count; i++) {
+        jfes_chunk_t *chunk = &chunks[i];
+        chunk->config = config;
+        chunk->json = json;
+        chunk->start = (jfes_size_t)((unsigned long long)length * i / threads_count);
+        chunk->end = (jfes_size_t)((unsigned long long)length * (i + 1) / threads_count);
+        chunk->last = 0;
+        chunk->quotes = 0;
+        chunk->tokens_count = 0;
+        chunk->tokens_capacity = i == 0 ? *max_tokens_count : (chunk->end - chunk->start) / 4 + 16;
+        chunk->tokens = i == 0 ? tokens : config->jfes_malloc(chunk->tokens_capacity * sizeof(jfes_token_t));
+        chunk->externals = JFES_NULL;
+        chunk->externals_capacity = 0;
+        chunk->depth = 0;
+        chunk->superior_token = -1;
+        chunk->offset = 0;
+        chunk->result = tokens;
+        chunk->status = jfes_unknown;
+    }
+
+    /* Quote parity of the previous chunks tells if the chunk starts inside a string. */
+    jfes_run_chunks(jfes_count_chunk_quotes, chunks, threads_count);
+
+    jfes_size_t quotes = chunks[0].quotes;
+    for (jfes_size_t i = 1; i < threads_count; i++) {
+        chunks[i].quotes += quotes;
+        quotes = chunks[i].quotes;
+    }
+
+    jfes_size_t next_start = length;
+    for (jfes_size_t i = threads_count - 1; i > 0; i--) {
+        jfes_chunk_t *chunk = &chunks[i];
+        chunk->start = jfes_find_chunk_start(json, chunk->start, next_start, (int)(chunks[i - 1].quotes % 2));
+        chunk->end = next_start;
+        next_start = chunk->start;
+    }
+    chunks[0].start = 0;
+    chunks[0].end = next_start;
+
+    /* Empty chunks have nothing to parse. */
+    jfes_size_t chunks_count = 0;
+    for (jfes_size_t i = 0; i < threads_count; i++) {
+        if (chunks[i].start < chunks[i].end) {
+            chunks[chunks_count++] = chunks[i];
+        }
+        else if (chunks[i].tokens && chunks[i].tokens != chunks[i].result) {
+            config->jfes_free(chunks[i].tokens);
+        }
+    }
+    chunks[chunks_count - 1].last = 1;
+
+    for (jfes_size_t i = 0; i < chunks_count; i++) {
+        if (!chunks[i].tokens) {
+            jfes_free_chunks(config, chunks, chunks_count);
+            return jfes_no_memory;
+        }
+    }
+
+    jfes_run_chunks(jfes_parse_chunk, chunks, chunks_count);
+
+    int superior_token = -1;
+    const jfes_size_t count = jfes_stitch_chunks(config, chunks, chunks_count, *max_tokens_count, &superior_token);
+    if (count == 0) {
+        jfes_free_chunks(config, chunks, chunks_count);
+        return jfes_parse_tokens(parser, json, length, tokens, max_tokens_count);
+    }
+
+    jfes_run_chunks(jfes_copy_chunk_tokens, chunks, chunks_count);
+
+    /* Sizes and ends of the containers which are continued by the other chunks. */
+    for (jfes_size_t i = 0; i < chunks_count; i++) {
+        const jfes_chunk_t *chunk = &chunks[i];
+        for (jfes_size_t depth = 0; depth <= chunk->depth; depth++) {
+            const jfes_chunk_external_t *external = &chunk->externals[depth];
+            if (external->index == -1) {
+                continue;
+            }
+
+            tokens[external->index].size += external->size;
+            if (depth < chunk->depth) {
+                tokens[external->index].end = external->end;
+            }
+        }
+    }
+
+    jfes_free_chunks(config, chunks, chunks_count);
+
+    jfes_reset_parser(parser);
+    parser->pos = length;
+    parser->next_token = count;
+    parser->superior_token = superior_token;
+
+    *max_tokens_count = count;
+    return jfes_success;
+}
+#endif
+
+/** The SAX parser is out of any string or primitive. */
+#define JFES_SAX_STATE_NONE             0
+
+/** The SAX parser is inside a string. */
+#define JFES_SAX_STATE_STRING           1
+
+/** The SAX parser is inside a primitive. */
+#define JFES_SAX_STATE_PRIMITIVE        2
+
+/** Escape sequence started: the next character is the escaped one. */
+#define JFES_ESCAPE_START               5
+
+/**
+    Checks if the container at the given depth is an object.
+
+    \param[in]      levels              Nesting levels bitset.
+    \param[in]      depth               Container depth, starting from zero.
+
+    \return         Non-zero if the container is an object.
+*/
+static int jfes_is_object_level(const unsigned char *levels, jfes_size_t depth) {
+    return (levels[depth / 8] >> (depth % 8)) & 1;
+}
+
+/**
+    Stores the container type at the given depth.
+
+    \param[in, out] levels              Nesting levels bitset.
+    \param[in]      depth               Container depth, starting from zero.
+    \param[in]      object              Non-zero for objects, zero for arrays.
+*/
+static void jfes_set_object_level(unsigned char *levels, jfes_size_t depth, int object) {
+    if (object) {
+        levels[depth / 8] |= (unsigned char)(1u << (depth % 8));
+    }
+    else {
+        levels[depth / 8] &= (unsigned char)~(1u << (depth % 8));
+    }
+}
+
+/**
+    Passes the finished string or primitive to the callback. If the value was
+    split between chunks, its tail is appended to the parser buffer first.
+
+    \param[in, out] parser              Pointer to the jfes_sax_parser_t object.
+    \param[in]      data                Value data in the current chunk.
+    \param[in]      length              Value data length in the current chunk.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_sax_emit(jfes_sax_parser_t *parser, const char *data, jfes_size_t length) {
+    if (parser->buffer_length > 0) {
+        if (length > parser->buffer_size - parser->buffer_length) {
+            return jfes_no_memory;
+        }
+
+        jfes_memcpy(parser->buffer + parser->buffer_length, data, length);
+        data = parser->buffer;
+        length += parser->buffer_length;
+        parser->buffer_length = 0;
+    }
+
+    jfes_sax_value_t value;
+    value.data = data;
+    value.length = length;
+    value.value.int_val = 0;
+
+    const int string = parser->state == JFES_SAX_STATE_STRING;
+    parser->state = JFES_SAX_STATE_NONE;
+
+    if (string) {
+#ifdef JFES_VALIDATE_UTF8
+        if (!jfes_is_valid_utf8(data, length)) {
+            return jfes_invalid_input;
+        }
+#endif
+        value.type = jfes_type_string;
+    }
+    else {
+        value.type = jfes_read_primitive(data, length, &value.value);
+#ifdef JFES_STRICT
+        if (value.type == jfes_type_undefined) {
+            return jfes_invalid_input;
+        }
+#endif
+    }
+
+    jfes_sax_event_t event = jfes_sax_value;
+    if (parser->expect_key) {
+#ifdef JFES_STRICT
+        if (!string) {
+            return jfes_invalid_input;
+        }
+#endif
+        event = jfes_sax_key;
+        parser->expect_key = 0;
+    }
+
+    return parser->callback(parser->context, event, &value) ? jfes_success : jfes_stopped;
+}
+
+/**
+    Keeps the unfinished string or primitive in the parser buffer until the next chunk.
+
+    \param[in, out] parser              Pointer to the jfes_sax_parser_t object.
+    \param[in]      data                Value data in the current chunk.
+    \param[in]      length              Value data length in the current chunk.
+
+    \return         jfes_success if everything is OK. jfes_no_memory if the buffer is too small.
+*/
+static jfes_status_t jfes_sax_keep(jfes_sax_parser_t *parser, const char *data, jfes_size_t length) {
+    if (length > parser->buffer_size - parser->buffer_length) {
+        return jfes_no_memory;
+    }
+
+    jfes_memcpy(parser->buffer + parser->buffer_length, data, length);
+    parser->buffer_length += length;
+    return jfes_success;
+}
+
+/**
+    Scans the string body. Validates escape sequences the same way as jfes_parse_string.
+
+    \param[in]      json                JSON data chunk.
+    \param[in]      pos                 Position to start from.
+    \param[in]      length              Chunk length.
+    \param[out]     end                 Position of the closing quote or `length` if the string continues.
+    \param[in, out] escape              State of the unfinished escape sequence. Zero at the string start.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_scan_string(const char *json, jfes_size_t pos, jfes_size_t length,
+        jfes_size_t *end, unsigned int *escape) {
+    for (; pos < length; pos++) {
+#ifdef JFES_USE_SIMD
+        if (*escape == 0) {
+            pos = jfes_find_string_special(json, pos, length);
+            if (pos >= length) {
+                break;
+            }
+        }
+#endif
+        const char c = json[pos];
+        if (*escape == JFES_ESCAPE_START) {
+            switch (c) {
+            case '\"': case '/': case '\\': case 'b': case 'f':
+            case 'r': case 'n': case 't':
+                *escape = 0;
+                break;
+
+            case 'u':
+                *escape = 4;
+                break;
+
+            default:
+                return jfes_invalid_input;
+            }
+        }
+        else if (*escape > 0) {
+            if ((c < '0' || c > '9') && (c < 'A' || c > 'F') && (c < 'a' || c > 'f')) {
+                return jfes_invalid_input;
+            }
+            (*escape)--;
+        }
+        else if (c == '\\') {
+            *escape = JFES_ESCAPE_START;
+        }
+        else if (c == '\"') {
+            break;
+        }
+        else if (c == '\0') {
+            return jfes_invalid_input;
+        }
+    }
+
+    *end = pos;
+    return jfes_success;
+}
+
+/**
+    Finds the end of the primitive.
+
+    \param[in]      json                JSON data chunk.
+    \param[in]      pos                 Position to start from.
+    \param[in]      length              Chunk length.
+
+    \return         Position of the delimiter or `length` if the primitive continues.
+*/
+static jfes_size_t jfes_scan_primitive(const char *json, jfes_size_t pos, jfes_size_t length) {
+    for (; pos < length; pos++) {
+        const char c = json[pos];
+        if (c == '\t' || c == '\n' || c == '\r' || c == ' ' ||
+            c == ',' || c == ']' || c == '}' || c == '\0'
+#ifndef JFES_STRICT
+            || c == ':'
+#endif
+            ) {
+            break;
+        }
+    }
+
+    return pos;
+}
+
+jfes_status_t jfes_init_sax_parser(jfes_sax_parser_t *parser, unsigned char *levels, jfes_size_t max_depth,
+        char *buffer, jfes_size_t buffer_size, jfes_sax_callback_t callback, void *context) {
+    if (!parser || !levels || max_depth == 0 || !buffer || buffer_size == 0 || !callback) {
+        return jfes_invalid_arguments;
+    }
+
+    parser->callback = callback;
+    parser->context = context;
+
+    parser->levels = levels;
+    parser->max_depth = max_depth;
+    parser->depth = 0;
+
+    parser->buffer = buffer;
+    parser->buffer_size = buffer_size;
+    parser->buffer_length = 0;
+
+    parser->state = JFES_SAX_STATE_NONE;
+    parser->escape = 0;
+    parser->expect_key = 0;
+
+    return jfes_success;
+}
+
+jfes_status_t jfes_sax_parse(jfes_sax_parser_t *parser, const char *json, jfes_size_t length) {
+    if (!parser || !json) {
+        return jfes_invalid_arguments;
+    }
+
+    jfes_status_t status = jfes_success;
+    jfes_size_t pos = 0;
+    while (pos < length) {
+        if (parser->state == JFES_SAX_STATE_STRING) {
+            jfes_size_t end = length;
+            status = jfes_scan_string(json, pos, length, &end, &parser->escape);
+            if (jfes_status_is_bad(status)) {
+                return status;
+            }
+
+            if (end == length) {
+                return jfes_sax_keep(parser, json + pos, length - pos);
+            }
+
+            status = jfes_sax_emit(parser, json + pos, end - pos);
+            if (jfes_status_is_bad(status)) {
+                return status;
+            }
+
+            pos = end + 1;
+            continue;
+        }
+
+        if (parser->state == JFES_SAX_STATE_PRIMITIVE) {
+            const jfes_size_t end = jfes_scan_primitive(json, pos, length);
+            if (end == length) {
+                return jfes_sax_keep(parser, json + pos, length - pos);
+            }
+
+            status = jfes_sax_emit(parser, json + pos, end - pos);
+            if (jfes_status_is_bad(status)) {
+                return status;
+            }
+
+            pos = end;
+            continue;
+        }
+
+        const char c = json[pos];
+        switch (c) {
+        case '{': case '[':
+            if (parser->depth >= parser->max_depth) {
+                return jfes_no_memory;
+            }
+
+            jfes_set_object_level(parser->levels, parser->depth, c == '{');
+            parser->depth++;
+            parser->expect_key = c == '{';
+
+            if (!parser->callback(parser->context, c == '{' ? jfes_sax_start_object : jfes_sax_start_array, JFES_NULL)) {
+                return jfes_stopped;
+            }
+            break;
+
+        case '}': case ']':
+            {
+                if (parser->depth == 0) {
+                    return jfes_invalid_input;
+                }
+
+                const int object = jfes_is_object_level(parser->levels, parser->depth - 1);
+#ifdef JFES_STRICT
+                if (object != (c == '}')) {
+                    return jfes_invalid_input;
+                }
+#endif
+                parser->depth--;
+                parser->expect_key = 0;
+
+                if (!parser->callback(parser->context, object ? jfes_sax_end_object : jfes_sax_end_array, JFES_NULL)) {
+                    return jfes_stopped;
+                }
+            }
+            break;
+
+        case '\"':
+            parser->state = JFES_SAX_STATE_STRING;
+            parser->escape = 0;
+            break;
+
+        case '\t': case '\r': case '\n': case ' ':
+            break;
+
+        case ':':
+            parser->expect_key = 0;
+            break;
+
+        case ',':
+            parser->expect_key = parser->depth > 0 && jfes_is_object_level(parser->levels, parser->depth - 1);
+            break;
+
+        case '\0':
+            return jfes_invalid_input;
+
+        default:
+            parser->state = JFES_SAX_STATE_PRIMITIVE;
+            pos--;
+            break;
+        }
+
+        pos++;
+    }
+
+    return jfes_success;
+}
+
+jfes_status_t jfes_sax_finish(jfes_sax_parser_t *parser) {
+    if (!parser) {
+        return jfes_invalid_arguments;
+    }
+
+    jfes_status_t status = jfes_success;
+    if (parser->state == JFES_SAX_STATE_PRIMITIVE) {
+        /* The end of data finishes the primitive. */
+        status = jfes_sax_emit(parser, parser->buffer + parser->buffer_length, 0);
+    }
+    else if (parser->state == JFES_SAX_STATE_STRING || parser->depth > 0) {
+        status = jfes_error_part;
+    }
+
+    parser->depth = 0;
+    parser->buffer_length = 0;
+    parser->state = JFES_SAX_STATE_NONE;
+    parser->escape = 0;
+    parser->expect_key = 0;
+
+    return status;
+}
+
+jfes_status_t jfes_sax_parse_reader(jfes_sax_parser_t *parser, jfes_reader_t reader, void *context,
+        char *window, jfes_size_t window_size) {
+    if (!parser || !reader || !window || window_size == 0) {
+        return jfes_invalid_arguments;
+    }
+
+    for (;;) {
+        const jfes_size_t count = reader(context, window, window_size);
+        if (count == 0) {
+            return jfes_sax_finish(parser);
+        }
+
+        jfes_status_t status = jfes_sax_parse(parser, window, count);
+        if (jfes_status_is_bad(status)) {
+            return status;
+        }
+    }
+}
+
+/** jfes_validate expects a value. */
+#define JFES_VALIDATE_VALUE             0
+
+/** jfes_validate expects an object key. */
+#define JFES_VALIDATE_KEY               1
+
+/** jfes_validate expects a colon after the key. */
+#define JFES_VALIDATE_COLON             2
+
+/** jfes_validate expects a comma or the end of the container. */
+#define JFES_VALIDATE_NEXT              3
+
+/**
+    Finds the quote, backslash or control character in the string body.
+
+    \param[in]      json                JSON data string.
+    \param[in]      pos                 Position to start from.
+    \param[in]      length              JSON data length.
+
+    \return         Position of the found character or `length` if there is none.
+*/
+static jfes_size_t jfes_find_string_stop(const char *json, jfes_size_t pos, jfes_size_t length) {
+#if defined(JFES_AVX2)
+    const __m256i quote = _mm256_set1_epi8('\"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1F);
+    while (pos + 32 <= length) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(json + pos));
+        const unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+            _mm256_cmpeq_epi8(_mm256_max_epu8(v, control), control)));
+        if (mask) {
+            return pos + jfes_count_trailing_zeros(mask);
+        }
+        pos += 32;
+    }
+#elif defined(JFES_SSE2)
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    while (pos + 16 <= length) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(json + pos));
+        const unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+            _mm_cmpeq_epi8(_mm_max_epu8(v, control), control)));
+        if (mask) {
+            return pos + jfes_count_trailing_zeros(mask);
+        }
+        pos += 16;
+    }
+#endif
+
+    while (pos < length) {
+        const unsigned char c = (unsigned char)json[pos];
+        if (c == '\"' || c == '\\' || c < 0x20) {
+            return pos;
+        }
+        pos++;
+    }
+
+    return length;
+}
+
+/**
+    Checks the string. Control characters must be escaped and
+    escape sequences must be valid.
+
+    \param[in]      json                JSON data string.
+    \param[in, out] pos                 Position of the opening quote.
+                                        Will contain the position after the closing quote.
+    \param[in]      length              JSON data length.
+
+    \return         jfes_success if the string is valid.
+*/
+static jfes_status_t jfes_validate_string(const char *json, jfes_size_t *pos, jfes_size_t length) {
+    jfes_size_t i = *pos + 1;
+    for (;;) {
+        i = jfes_find_string_stop(json, i, length);
+        if (i >= length) {
+            return jfes_error_part;
+        }
+
+        const char c = json[i++];
+        if (c == '\"') {
+#ifdef JFES_VALIDATE_UTF8
+            if (!jfes_is_valid_utf8(json + *pos + 1, i - *pos - 2)) {
+                return jfes_invalid_input;
+            }
+#endif
+            *pos = i;
+            return jfes_success;
+        }
+        else if (c != '\\') {
+            return jfes_invalid_input;
+        }
+
+        if (i >= length) {
+            return jfes_error_part;
+        }
+
+        switch (json[i++]) {
+        case '\"': case '/': case '\\': case 'b': case 'f':
+        case 'r': case 'n': case 't':
+            break;
+
+        case 'u':
+            for (int j = 0; j < 4; j++, i++) {
+                if (i >= length) {
+                    return jfes_error_part;
+                }
+
+                const char h = json[i];
+                if ((h < '0' || h > '9') && (h < 'A' || h > 'F') && (h < 'a' || h > 'f')) {
+                    return jfes_invalid_input;
+                }
+            }
+            break;
+
+        default:
+            return jfes_invalid_input;
+        }
+    }
+}
+
+/**
+    Checks the number: an optional minus, an integer part without leading zeros,
+    an optional fraction and an optional exponent.
+
+    \param[in]      json                JSON data string.
+    \param[in, out] pos                 Position of the number start.
+                                        Will contain the position after the number.
+    \param[in]      length              JSON data length.
+
+    \return         jfes_success if the number is valid.
+*/
+static jfes_status_t jfes_validate_number(const char *json, jfes_size_t *pos, jfes_size_t length) {
+    jfes_size_t i = *pos;
+
+    if (json[i] == '-') {
+        i++;
+    }
+
+    if (i >= length) {
+        return jfes_error_part;
+    }
+    if (json[i] == '0') {
+        i++;
+    }
+    else if (json[i] >= '1' && json[i] <= '9') {
+        while (++i < length && json[i] >= '0' && json[i] <= '9');
+    }
+    else {
+        return jfes_invalid_input;
+    }
+
+    if (i < length && json[i] == '.') {
+        if (++i >= length) {
+            return jfes_error_part;
+        }
+        if (json[i] < '0' || json[i] > '9') {
+            return jfes_invalid_input;
+        }
+        while (++i < length && json[i] >= '0' && json[i] <= '9');
+    }
+
+    if (i < length && (json[i] == 'e' || json[i] == 'E')) {
+        if (++i < length && (json[i] == '+' || json[i] == '-')) {
+            i++;
+        }
+        if (i >= length) {
+            return jfes_error_part;
+        }
+        if (json[i] < '0' || json[i] > '9') {
+            return jfes_invalid_input;
+        }
+        while (++i < length && json[i] >= '0' && json[i] <= '9');
+    }
+
+    *pos = i;
+    return jfes_success;
+}
+
+/**
+    Checks the literal.
+
+    \param[in]      json                JSON data string.
+    \param[in, out] pos                 Position of the literal start.
+                                        Will contain the position after the literal.
+    \param[in]      length              JSON data length.
+    \param[in]      literal             Expected literal.
+    \param[in]      literal_length      Expected literal length.
+
+    \return         jfes_success if the literal matches.
+*/
+static jfes_status_t jfes_validate_literal(const char *json, jfes_size_t *pos, jfes_size_t length,
+        const char *literal, jfes_size_t literal_length) {
+    const jfes_size_t available = length - *pos;
+    if (available < literal_length) {
+        return jfes_memcmp(json + *pos, literal, available) ? jfes_invalid_input : jfes_error_part;
+    }
+    if (jfes_memcmp(json + *pos, literal, literal_length)) {
+        return jfes_invalid_input;
+    }
+
+    *pos += literal_length;
+    return jfes_success;
+}
+
+jfes_status_t jfes_validate(const char *json, jfes_size_t length, unsigned char *levels, jfes_size_t max_depth) {
+    if (!json || length == 0 || (!levels && max_depth > 0)) {
+        return jfes_invalid_arguments;
+    }
+
+    jfes_size_t pos = 0;
+    jfes_size_t depth = 0;
+    int state = JFES_VALIDATE_VALUE;
+    int empty = 0;
+
+    for (;;) {
+        while (pos < length && (json[pos] == ' ' || json[pos] == '\n' || json[pos] == '\r' || json[pos] == '\t')) {
+            pos++;
+        }
+
+        if (pos >= length) {
+            return depth == 0 && state == JFES_VALIDATE_NEXT ? jfes_success : jfes_error_part;
+        }
+
+        const char c = json[pos];
+        jfes_status_t status = jfes_success;
+
+        switch (state) {
+        case JFES_VALIDATE_VALUE:
+            switch (c) {
+            case '{': case '[':
+                if (depth >= max_depth) {
+                    return jfes_no_memory;
+                }
+                jfes_set_object_level(levels, depth++, c == '{');
+                state = c == '{' ? JFES_VALIDATE_KEY : JFES_VALIDATE_VALUE;
+                empty = 1;
+                pos++;
+                continue;
+
+            case ']':
+                if (!empty || jfes_is_object_level(levels, depth - 1)) {
+                    return jfes_invalid_input;
+                }
+                depth--;
+                pos++;
+                break;
+
+            case '\"':
+                status = jfes_validate_string(json, &pos, length);
+                break;
+
+            case 't':
+                status = jfes_validate_literal(json, &pos, length, JFES_TRUE_VALUE, sizeof(JFES_TRUE_VALUE) - 1);
+                break;
+
+            case 'f':
+                status = jfes_validate_literal(json, &pos, length, JFES_FALSE_VALUE, sizeof(JFES_FALSE_VALUE) - 1);
+                break;
+
+            case 'n':
+                status = jfes_validate_literal(json, &pos, length, JFES_NULL_VALUE, sizeof(JFES_NULL_VALUE) - 1);
+                break;
+
+            default:
+                if (c != '-' && (c < '0' || c > '9')) {
+                    return jfes_invalid_input;
+                }
+                status = jfes_validate_number(json, &pos, length);
+                break;
+            }
+            state = JFES_VALIDATE_NEXT;
+            break;
+
+        case JFES_VALIDATE_KEY:
+            if (c == '\"') {
+                status = jfes_validate_string(json, &pos, length);
+                state = JFES_VALIDATE_COLON;
+            }
+            else if (c == '}' && empty) {
+                depth--;
+                pos++;
+                state = JFES_VALIDATE_NEXT;
+            }
+            else {
+                return jfes_invalid_input;
+            }
+            break;
+
+        case JFES_VALIDATE_COLON:
+            if (c != ':') {
+                return jfes_invalid_input;
+            }
+            state = JFES_VALIDATE_VALUE;
+            pos++;
+            break;
+
+        default:
+            if (depth == 0) {
+                return jfes_invalid_input;
+            }
+
+            if (c == ',') {
+                state = jfes_is_object_level(levels, depth - 1) ? JFES_VALIDATE_KEY : JFES_VALIDATE_VALUE;
+            }
+            else if (c != (jfes_is_object_level(levels, depth - 1) ? '}' : ']')) {
+                return jfes_invalid_input;
+            }
+            else {
+                depth--;
+            }
+            pos++;
+            break;
+        }
+
+        if (jfes_status_is_bad(status)) {
+            return status;
+        }
+        empty = 0;
+    }
+}
+
+jfes_status_t jfes_compact_tokens(const jfes_token_t *tokens, jfes_size_t tokens_count,
+        jfes_compact_token_t *compact_tokens) {
+    if (!tokens || !compact_tokens || tokens_count == 0) {
+        return jfes_invalid_arguments;
+    }
+
+    for (jfes_size_t i = 0; i < tokens_count; i++) {
+        if (tokens[i].start < 0 || (unsigned int)tokens[i].start > JFES_COMPACT_MAX_START) {
+            return jfes_invalid_arguments;
+        }
+
+        compact_tokens[i].info = ((unsigned int)tokens[i].start << JFES_COMPACT_TYPE_BITS) | (unsigned int)tokens[i].type;
+        compact_tokens[i].next = i + 1;
+    }
+
+    /* Children always follow their parents, so subtree ends can be collected backwards. */
+    for (jfes_size_t i = tokens_count; i-- > 0;) {
+        const int parent = tokens[i].parent;
+        if (parent != -1 && compact_tokens[parent].next < compact_tokens[i].next) {
+            compact_tokens[parent].next = compact_tokens[i].next;
+        }
+    }
+
+    return jfes_success;
+}
+
+/**
+    Finds the end of the string or primitive token.
+
+    \param[in]      json                JSON data string.
+    \param[in]      length              JSON data length.
+    \param[in]      type                Token type.
+    \param[in]      start               Token start position.
+
+    \return         Token end position.
+*/
+static jfes_size_t jfes_find_token_end(const char *json, jfes_size_t length, jfes_token_type_t type, jfes_size_t start) {
+    jfes_size_t pos = start;
+
+    if (type == jfes_type_string) {
+        while (pos < length && json[pos] != '\"') {
+            pos += json[pos] == '\\' ? 2 : 1;
+        }
+        return pos < length ? pos : length;
+    }
+
+    while (pos < length && json[pos] != '\0') {
+        char c = json[pos];
+        if (c == '\t' || c == '\n' || c == '\r' || c == ' ' ||
+            c == ',' || c == ']' || c == '}'
+#ifndef JFES_STRICT
+            || c == ':'
+#endif
+            ) {
+            break;
+        }
+        pos++;
+    }
+
+    return pos;
+}
+
+jfes_status_t jfes_expand_tokens(const char *json, jfes_size_t length,
+        const jfes_compact_token_t *compact_tokens, jfes_size_t tokens_count, jfes_token_t *tokens) {
+    if (!json || length == 0 || !compact_tokens || !tokens || tokens_count == 0) {
+        return jfes_invalid_arguments;
+    }
+
+    /* Position right after the last finished token. Closing brackets are searched from here. */
+    jfes_size_t cursor = 0;
+
+    for (jfes_size_t i = 0; i <= tokens_count; i++) {
+        /* Close all containers whose subtrees end before this token. */
+        int open = (int)i - 1;
+        while (open != -1 && compact_tokens[open].next <= i) {
+            if (tokens[open].type == jfes_type_array || tokens[open].type == jfes_type_object) {
+                while (cursor < length && json[cursor] != ']' && json[cursor] != '}') {
+                    cursor++;
+                }
+                if (cursor == length) {
+                    return jfes_invalid_input;
+                }
+                tokens[open].end = (int)++cursor;
+            }
+            open = tokens[open].parent;
+        }
+
+        if (i == tokens_count) {
+            break;
+        }
+
+        jfes_token_t *token = &tokens[i];
+        token->type = jfes_compact_token_type(&compact_tokens[i]);
+        token->start = (int)jfes_compact_token_start(&compact_tokens[i]);
+        token->size = 0;
+        token->parent = open;
+        if (open != -1) {
+            tokens[open].size++;
+        }
+
+        if (token->type == jfes_type_array || token->type == jfes_type_object) {
+            token->end = -1;
+            cursor = token->start + 1;
+        }
+        else {
+            token->end = (int)jfes_find_token_end(json, length, token->type, token->start);
+            cursor = token->end + (token->type == jfes_type_string ? 1 : 0);
+#ifdef JFES_TOKEN_VALUES
+            if (token->type != jfes_type_string) {
+                jfes_read_primitive(json + token->start, (jfes_size_t)(token->end - token->start), &token->value);
+            }
+#endif
+        }
+    }
+
+    return jfes_success;
+}
+
+jfes_token_type_t jfes_compact_token_type(const jfes_compact_token_t *token) {
+    return (jfes_token_type_t)(token->info & ((1u << JFES_COMPACT_TYPE_BITS) - 1));
+}
+
+jfes_size_t jfes_compact_token_start(const jfes_compact_token_t *token) {
+    return token->info >> JFES_COMPACT_TYPE_BITS;
+}
+
+/**
+    Returns decoded value of the boolean or number token.
+
+    \param[in]      json                JSON data string.
+    \param[in]      token               Boolean or number token.
+    \param[out]     value               Decoded value.
+*/
+static void jfes_get_token_value(const char *json, const jfes_token_t *token, jfes_token_value_t *value) {
+#ifdef JFES_TOKEN_VALUES
+    (void)json;
+    *value = token->value;
+#else
+    jfes_read_primitive(json + token->start, (jfes_size_t)(token->end - token->start), value);
+#endif
+}
+
+/**
+    Finds the first token after the subtree of the given token.
+
+    \param[in]      tokens              Tokens array.
+    \param[in]      tokens_count        Tokens count.
+    \param[in]      index               Token index.
+
+    \return         Index of the first token after the subtree.
+*/
+static jfes_size_t jfes_skip_token(const jfes_token_t *tokens, jfes_size_t tokens_count, jfes_size_t index) {
+    const jfes_token_t *token = &tokens[index];
+
+    if (token->type == jfes_type_array || token->type == jfes_type_object) {
+        /* Tokens are ordered by start, and all nested tokens start before the container end. */
+        jfes_size_t low = index + 1;
+        jfes_size_t high = tokens_count;
+        while (low < high) {
+            jfes_size_t middle = low + (high - low) / 2;
+            if (tokens[middle].start < token->end) {
+                low = middle + 1;
+            }
+            else {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+    /* Object keys own their values. */
+    jfes_size_t next = index + 1;
+    for (jfes_size_t i = 0; i < token->size && next < tokens_count; i++) {
+        next = jfes_skip_token(tokens, tokens_count, next);
+    }
+    return next;
+}
+
+/**
+    Compares JSON Pointer reference token with the token data.
+    Escape sequences of the data are decoded as in the string values.
+
+    \param[in]      reference           Reference token with `~0` and `~1` escapes.
+    \param[in]      reference_length    Reference token length.
+    \param[in]      data                Raw token data as it is written in JSON.
+    \param[in]      data_length         Token data length.
+
+    \return         Non-zero if they are equal.
+*/
+static int jfes_pointer_reference_equals(const char *reference, jfes_size_t reference_length,
+        const char *data, jfes_size_t data_length) {
+    /* The decoded escape sequence which is being compared. */
+    char sequence[4];
+    jfes_size_t sequence_length = 0;
+    jfes_size_t sequence_pos = 0;
+
+    jfes_size_t j = 0;
+    for (jfes_size_t i = 0; i < reference_length; i++) {
+        char c = reference[i];
+        if (c == '~') {
+            c = reference[++i] == '1' ? '/' : '~';
+        }
+
+        if (sequence_pos == sequence_length) {
+            if (j >= data_length) {
+                return 0;
+            }
+            if (data[j] != '\\') {
+                if (data[j++] != c) {
+                    return 0;
+                }
+                continue;
+            }
+
+            sequence_length = jfes_write_utf8(sequence, jfes_read_escape(data, data_length, &j));
+            sequence_pos = 0;
+        }
+
+        if (sequence[sequence_pos++] != c) {
+            return 0;
+        }
+    }
+
+    return sequence_pos == sequence_length && j == data_length;
+}
+
+/**
+    Checks the escapes of JSON Pointer reference token: `~` must be followed by `0` or `1`.
+
+    \param[in]      reference           Reference token.
+    \param[in]      reference_length    Reference token length.
+
+    \return         Non-zero if the reference token is valid.
+*/
+static int jfes_pointer_reference_is_valid(const char *reference, jfes_size_t reference_length) {
+    for (jfes_size_t i = 0; i < reference_length; i++) {
+        if (reference[i] == '~') {
+            if (++i >= reference_length || (reference[i] != '0' && reference[i] != '1')) {
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+/**
+    Reads the array index from JSON Pointer reference token.
+
+    \param[in]      reference           Reference token.
+    \param[in]      reference_length    Reference token length.
+
+    \return         Array index or -1 if the reference is not an index.
+*/
+static int jfes_pointer_reference_index(const char *reference, jfes_size_t reference_length) {
+    if (reference_length == 0 || reference_length >= 10 || (reference[0] == '0' && reference_length > 1)) {
+        return -1;
+    }
+
+    int index = 0;
+    for (jfes_size_t i = 0; i < reference_length; i++) {
+        if (reference[i] < '0' || reference[i] > '9') {
+            return -1;
+        }
+        index = index * 10 + (reference[i] - '0');
+    }
+
+    return index;
+}
+
+jfes_status_t jfes_find_token(const jfes_tokens_data_t *tokens_data, const char *pointer,
+        jfes_size_t pointer_length, jfes_size_t *index) {
+    if (!tokens_data || !tokens_data->tokens || tokens_data->tokens_count == 0 || !pointer || !index) {
+        return jfes_invalid_arguments;
+    }
+
+    if (pointer_length == 0) {
+        pointer_length = jfes_strlen(pointer);
+    }
+
+    const jfes_token_t *tokens = tokens_data->tokens;
+    const jfes_size_t tokens_count = tokens_data->tokens_count;
+
+    jfes_size_t current = 0;
+    jfes_size_t pos = 0;
+    while (pos < pointer_length) {
+        if (pointer[pos] != '/') {
+            return jfes_invalid_arguments;
+        }
+
+        const char *reference = pointer + ++pos;
+        while (pos < pointer_length && pointer[pos] != '/') {
+            pos++;
+        }
+        const jfes_size_t reference_length = (jfes_size_t)(pointer + pos - reference);
+        if (!jfes_pointer_reference_is_valid(reference, reference_length)) {
+            return jfes_invalid_arguments;
+        }
+
+        const jfes_token_t *token = &tokens[current];
+        jfes_size_t child = current + 1;
+        int found = 0;
+
+        if (token->type == jfes_type_object) {
+            for (jfes_size_t i = 0; i < token->size && child < tokens_count; i++) {
+                const jfes_token_t *key = &tokens[child];
+                if (key->size > 0 && jfes_pointer_reference_equals(reference, reference_length,
+                        tokens_data->json_data + key->start, key->end - key->start)) {
+                    child++;
+                    found = 1;
+                    break;
+                }
+                child = jfes_skip_token(tokens, tokens_count, child);
+            }
+        }
+        else if (token->type == jfes_type_array) {
+            const int item = jfes_pointer_reference_index(reference, reference_length);
+            if (item >= 0 && (jfes_size_t)item < token->size) {
+                for (jfes_size_t i = 0; i < (jfes_size_t)item && child < tokens_count; i++) {
+                    child = jfes_skip_token(tokens, tokens_count, child);
+                }
+                found = child < tokens_count;
+            }
+        }
+
+        if (!found) {
+            return jfes_not_found;
+        }
+        current = child;
+    }
+
+    *index = current;
+    return jfes_success;
+}
+
+jfes_status_t jfes_get_integer(const jfes_tokens_data_t *tokens_data, const char *pointer,
+        jfes_size_t pointer_length, jfes_integer_t *value) {
+    if (!value) {
+        return jfes_invalid_arguments;
+    }
+
+    jfes_size_t index = 0;
+    jfes_status_t status = jfes_find_token(tokens_data, pointer, pointer_length, &index);
+    if (jfes_status_is_bad(status)) {
+        return status;
+    }
+
+    const jfes_token_t *token = &tokens_data->tokens[index];
+    if (token->type != jfes_type_integer) {
+        return jfes_wrong_type;
+    }
+
+    jfes_token_value_t token_value;
+    jfes_get_token_value(tokens_data->json_data, token, &token_value);
+
+    *value = token_value.int_val;
+    return jfes_success;
+}
+
+jfes_status_t jfes_get_double(const jfes_tokens_data_t *tokens_data, const char *pointer,
+        jfes_size_t pointer_length, double *value) {
+    if (!value) {
+        return jfes_invalid_arguments;
+    }
+
+    jfes_size_t index = 0;
+    jfes_status_t status = jfes_find_token(tokens_data, pointer, pointer_length, &index);
+    if (jfes_status_is_bad(status)) {
+        return status;
+    }
+
+    const jfes_token_t *token = &tokens_data->tokens[index];
+    if (token->type != jfes_type_integer && token->type != jfes_type_double) {
+        return jfes_wrong_type;
+    }
+
+    jfes_token_value_t token_value;
+    jfes_get_token_value(tokens_data->json_data, token, &token_value);
+
+    *value = token->type == jfes_type_integer ? (double)token_value.int_val : token_value.double_val;
+    return jfes_success;
+}
+
+jfes_status_t jfes_get_boolean(const jfes_tokens_data_t *tokens_data, const char *pointer,
+        jfes_size_t pointer_length, int *value) {
+    if (!value) {
+        return jfes_invalid_arguments;
+    }
+
+    jfes_size_t index = 0;
+    jfes_status_t status = jfes_find_token(tokens_data, pointer, pointer_length, &index);
+    if (jfes_status_is_bad(status)) {
+        return status;
+    }
+
+    const jfes_token_t *token = &tokens_data->tokens[index];
+    if (token->type != jfes_type_boolean) {
+        return jfes_wrong_type;
+    }
+
+    jfes_token_value_t token_value;
+    jfes_get_token_value(tokens_data->json_data, token, &token_value);
+
+    *value = token_value.bool_val;
+    return jfes_success;
+}
+
+jfes_status_t jfes_get_string_view(const jfes_tokens_data_t *tokens_data, const char *pointer,
+        jfes_size_t pointer_length, const char **data, jfes_size_t *length) {
+    if (!data || !length) {
+        return jfes_invalid_arguments;
+    }
+
+    jfes_size_t index = 0;
+    jfes_status_t status = jfes_find_token(tokens_data, pointer, pointer_length, &index);
+    if (jfes_status_is_bad(status)) {
+        return status;
+    }
+
+    const jfes_token_t *token = &tokens_data->tokens[index];
+    if (token->type != jfes_type_string) {
+        return jfes_wrong_type;
+    }
+
+    *data = tokens_data->json_data + token->start;
+    *length = (jfes_size_t)(token->end - token->start);
+    return jfes_success;
+}
+
+/**
+    Fills the current cursor key or value with the string or primitive.
+
+    \param[in, out] cursor              Pointer to the jfes_cursor_t object.
+    \param[in]      type                Value type or jfes_type_undefined to read the primitive.
+    \param[in]      start               Value start.
+    \param[in]      end                 Value end.
+    \param[in]      key                 Non-zero if the value is an object key.
+    \param[in]      decode              Non-zero to read the primitive. Otherwise its type stays undefined.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_cursor_set_value(jfes_cursor_t *cursor, jfes_token_type_t type,
+        jfes_size_t start, jfes_size_t end, int key, int decode) {
+    cursor->event = key ? jfes_sax_key : jfes_sax_value;
+    cursor->value.data = cursor->json + start;
+    cursor->value.length = end - start;
+    cursor->value.value.int_val = 0;
+    cursor->value.type = type;
+
+    if (type == jfes_type_undefined && decode) {
+        cursor->value.type = jfes_read_primitive(cursor->value.data, cursor->value.length, &cursor->value.value);
+#ifdef JFES_STRICT
+        if (key || cursor->value.type == jfes_type_undefined) {
+            return jfes_invalid_input;
+        }
+#endif
+    }
+
+    return jfes_success;
+}
+
+/**
+    Slides the cursor window: drops the data before `keep` and reads the next bytes after the rest.
+
+    \param[in, out] cursor              Pointer to the jfes_cursor_t object.
+    \param[in]      keep                Position of the first byte to keep.
+
+    \return         jfes_success if some bytes were read. jfes_not_found at the end of data
+                    or without the reader. jfes_no_memory if the window is full.
+*/
+static jfes_status_t jfes_cursor_refill(jfes_cursor_t *cursor, jfes_size_t keep) {
+    if (!cursor->reader) {
+        return jfes_not_found;
+    }
+
+    const jfes_size_t rest = cursor->length - keep;
+    if (rest >= cursor->window_size) {
+        return jfes_no_memory;
+    }
+
+    if (keep > 0 && rest > 0) {
+        jfes_memmove(cursor->window, cursor->window + keep, rest);
+    }
+
+    const jfes_size_t count = cursor->reader(cursor->reader_context, cursor->window + rest, cursor->window_size - rest);
+    cursor->length = rest + count;
+    return count > 0 ? jfes_success : jfes_not_found;
+}
+
+/**
+    Reads the next event from the raw data. The rules are the same as in jfes_sax_parse.
+
+    \param[in, out] cursor              Pointer to the jfes_cursor_t object.
+    \param[in]      decode              Non-zero to read the primitive values.
+
+    \return         jfes_success if everything is OK. jfes_not_found at the end of data.
+*/
+static jfes_status_t jfes_cursor_next_raw(jfes_cursor_t *cursor, int decode) {
+    const char *json = cursor->json;
+    jfes_size_t length = cursor->length;
+
+    jfes_size_t pos = cursor->pos;
+    for (;;) {
+        while (pos < length && json[pos] != '\0') {
+            const char c = json[pos];
+            switch (c) {
+            case '\t': case '\r': case '\n': case ' ':
+                pos++;
+                continue;
+
+            case ':':
+                cursor->expect_key = 0;
+                pos++;
+                continue;
+
+            case ',':
+                cursor->expect_key = cursor->depth > 0 && jfes_is_object_level(cursor->levels, cursor->depth - 1);
+                pos++;
+                continue;
+
+            case '{': case '[':
+                if (cursor->depth >= cursor->max_depth) {
+                    return jfes_no_memory;
+                }
+
+                jfes_set_object_level(cursor->levels, cursor->depth, c == '{');
+                cursor->depth++;
+                cursor->expect_key = c == '{';
+                cursor->event = c == '{' ? jfes_sax_start_object : jfes_sax_start_array;
+                cursor->pos = pos + 1;
+                return jfes_success;
+
+            case '}': case ']':
+                {
+                    if (cursor->depth == 0) {
+                        return jfes_invalid_input;
+                    }
+
+                    const int object = jfes_is_object_level(cursor->levels, cursor->depth - 1);
+#ifdef JFES_STRICT
+                    if (object != (c == '}')) {
+                        return jfes_invalid_input;
+                    }
+#endif
+                    cursor->depth--;
+                    cursor->expect_key = 0;
+                    cursor->event = object ? jfes_sax_end_object : jfes_sax_end_array;
+                    cursor->pos = pos + 1;
+                }
+                return jfes_success;
+
+            case '\"':
+                {
+                    jfes_size_t end = length;
+                    unsigned int escape = 0;
+                    jfes_status_t status = jfes_scan_string(json, pos + 1, length, &end, &escape);
+                    if (jfes_status_is_bad(status)) {
+                        return status;
+                    }
+                    if (end == length) {
+                        /* The string is split by the window end: slide to it and scan again. */
+                        status = jfes_cursor_refill(cursor, pos);
+                        if (status == jfes_success) {
+                            pos = 0;
+                            length = cursor->length;
+                            continue;
+                        }
+                        return status == jfes_no_memory ? jfes_no_memory : jfes_error_part;
+                    }
+#ifdef JFES_VALIDATE_UTF8
+                    if (!jfes_is_valid_utf8(json + pos + 1, end - pos - 1)) {
+                        return jfes_invalid_input;
+                    }
+#endif
+
+                    const int key = cursor->expect_key;
+                    cursor->expect_key = 0;
+                    cursor->pos = end + 1;
+                    return jfes_cursor_set_value(cursor, jfes_type_string, pos + 1, end, key, decode);
+                }
+
+            default:
+                {
+                    jfes_size_t end = jfes_scan_primitive(json, pos, length);
+                    if (end == length && cursor->reader) {
+                        jfes_status_t status = jfes_cursor_refill(cursor, pos);
+                        if (status == jfes_no_memory) {
+                            return status;
+                        }
+
+                        pos = 0;
+                        length = cursor->length;
+                        if (status == jfes_success) {
+                            continue;
+                        }
+                        /* The end of data finishes the primitive. */
+                        end = length;
+                    }
+
+                    const int key = cursor->expect_key;
+                    cursor->expect_key = 0;
+                    cursor->pos = end;
+                    return jfes_cursor_set_value(cursor, jfes_type_undefined, pos, end, key, decode);
+                }
+            }
+        }
+
+        if (pos < length || jfes_cursor_refill(cursor, pos) != jfes_success) {
+            break;
+        }
+        pos = 0;
+        length = cursor->length;
+    }
+
+    cursor->pos = pos;
+    return cursor->depth > 0 ? jfes_error_part : jfes_not_found;
+}
+
+/**
+    Finds the innermost container of the token.
+
+    \param[in]      tokens              Tokens array.
+    \param[in]      index               Index of the token to start from.
+
+    \return         Index of the container or -1 if there is no one.
+*/
+static int jfes_get_container(const jfes_token_t *tokens, int index) {
+    while (index != -1 && tokens[index].type != jfes_type_array && tokens[index].type != jfes_type_object) {
+        index = tokens[index].parent;
+    }
+
+    return index;
+}
+
+/**
+    Reads the next event from the tokens.
+
+    \param[in, out] cursor              Pointer to the jfes_cursor_t object.
+    \param[in]      decode              Non-zero to read the primitive values.
+
+    \return         jfes_success if everything is OK. jfes_not_found at the end of data.
+*/
+static jfes_status_t jfes_cursor_next_token(jfes_cursor_t *cursor, int decode) {
+    const jfes_token_t *tokens = cursor->tokens;
+
+    if (cursor->container != -1) {
+        const jfes_token_t *container = &tokens[cursor->container];
+        if (cursor->pos >= cursor->tokens_count || tokens[cursor->pos].start >= container->end) {
+            cursor->event = container->type == jfes_type_object ? jfes_sax_end_object : jfes_sax_end_array;
+            cursor->container = jfes_get_container(tokens, container->parent);
+            cursor->depth--;
+            return jfes_success;
+        }
+    }
+
+    if (cursor->pos >= cursor->tokens_count) {
+        return jfes_not_found;
+    }
+
+    const int index = (int)cursor->pos++;
+    const jfes_token_t *token = &tokens[index];
+    if (token->type == jfes_type_array || token->type == jfes_type_object) {
+        cursor->event = token->type == jfes_type_object ? jfes_sax_start_object : jfes_sax_start_array;
+        cursor->container = index;
+        cursor->depth++;
+        return jfes_success;
+    }
+
+    const int key = token->parent != -1 && tokens[token->parent].type == jfes_type_object;
+    jfes_cursor_set_value(cursor, token->type, (jfes_size_t)token->start, (jfes_size_t)token->end, key, decode);
+    if (decode && (token->type == jfes_type_boolean || token->type == jfes_type_integer || token->type == jfes_type_double)) {
+        jfes_get_token_value(cursor->json, token, &cursor->value.value);
+    }
+    return jfes_success;
+}
+
+/**
+    Moves the cursor to the next event.
+
+    \param[in, out] cursor              Pointer to the jfes_cursor_t object.
+    \param[in]      decode              Non-zero to read the primitive values. Skipped values don't need it.
+
+    \return         jfes_success if everything is OK. jfes_not_found at the end of data.
+*/
+static jfes_status_t jfes_cursor_move(jfes_cursor_t *cursor, int decode) {
+    return cursor->tokens ? jfes_cursor_next_token(cursor, decode) : jfes_cursor_next_raw(cursor, decode);
+}
+
+/**
+    Reads the primitive of the current value which was moved to without decoding.
+
+    \param[in, out] cursor              Pointer to the jfes_cursor_t object.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_cursor_decode(jfes_cursor_t *cursor) {
+    if (cursor->event != jfes_sax_value) {
+        return jfes_success;
+    }
+
+    if (cursor->tokens) {
+        const jfes_token_t *token = &cursor->tokens[cursor->pos - 1];
+        if (token->type == jfes_type_boolean || token->type == jfes_type_integer || token->type == jfes_type_double) {
+            jfes_get_token_value(cursor->json, token, &cursor->value.value);
+        }
+        return jfes_success;
+    }
+
+    if (cursor->value.type != jfes_type_undefined) {
+        return jfes_success;
+    }
+    return jfes_cursor_set_value(cursor, jfes_type_undefined, (jfes_size_t)(cursor->value.data - cursor->json),
+        (jfes_size_t)(cursor->value.data - cursor->json) + cursor->value.length, 0, 1);
+}
+
+jfes_status_t jfes_init_cursor(jfes_cursor_t *cursor, const char *json, jfes_size_t length,
+        unsigned char *levels, jfes_size_t max_depth) {
+    if (!cursor || !json || !levels || max_depth == 0) {
+        return jfes_invalid_arguments;
+    }
+
+    cursor->json = json;
+    cursor->length = length;
+
+    cursor->tokens = JFES_NULL;
+    cursor->tokens_count = 0;
+    cursor->container = -1;
+
+    cursor->pos = 0;
+    cursor->levels = levels;
+    cursor->max_depth = max_depth;
+    cursor->depth = 0;
+    cursor->expect_key = 0;
+
+    cursor->reader = JFES_NULL;
+    cursor->reader_context = JFES_NULL;
+    cursor->window = JFES_NULL;
+    cursor->window_size = 0;
+
+    cursor->event = jfes_sax_value;
+    cursor->value.type = jfes_type_undefined;
+    cursor->value.data = JFES_NULL;
+    cursor->value.length = 0;
+    cursor->value.value.int_val = 0;
+
+    return jfes_success;
+}
+
+jfes_status_t jfes_init_reader_cursor(jfes_cursor_t *cursor, jfes_reader_t reader, void *context,
+        char *window, jfes_size_t window_size, unsigned char *levels, jfes_size_t max_depth) {
+    if (!reader || !window || window_size == 0) {
+        return jfes_invalid_arguments;
+    }
+
+    jfes_status_t status = jfes_init_cursor(cursor, window, 0, levels, max_depth);
+    if (jfes_status_is_bad(status)) {
+        return status;
+    }
+
+    cursor->reader = reader;
+    cursor->reader_context = context;
+    cursor->window = window;
+    cursor->window_size = window_size;
+
+    return jfes_success;
+}
+
+jfes_status_t jfes_init_tokens_cursor(jfes_cursor_t *cursor, const char *json, jfes_size_t length,
+        const jfes_token_t *tokens, jfes_size_t tokens_count) {
+    if (!cursor || !json || (!tokens && tokens_count > 0)) {
+        return jfes_invalid_arguments;
+    }
+
+    cursor->json = json;
+    cursor->length = length;
+
+    cursor->tokens = tokens;
+    cursor->tokens_count = tokens_count;
+    cursor->container = -1;
+
+    cursor->pos = 0;
+    cursor->levels = JFES_NULL;
+    cursor->max_depth = 0;
+    cursor->depth = 0;
+    cursor->expect_key = 0;
+
+    cursor->reader = JFES_NULL;
+    cursor->reader_context = JFES_NULL;
+    cursor->window = JFES_NULL;
+    cursor->window_size = 0;
+
+    cursor->event = jfes_sax_value;
+    cursor->value.type = jfes_type_undefined;
+    cursor->value.data = JFES_NULL;
+    cursor->value.length = 0;
+    cursor->value.value.int_val = 0;
+
+    return jfes_success;
+}
+
+jfes_status_t jfes_cursor_next(jfes_cursor_t *cursor) {
+    if (!cursor) {
+        return jfes_invalid_arguments;
+    }
+
+    return jfes_cursor_move(cursor, 1);
+}
+
+jfes_status_t jfes_cursor_skip(jfes_cursor_t *cursor) {
+    if (!cursor) {
+        return jfes_invalid_arguments;
+    }
+
+    if (cursor->event == jfes_sax_key) {
+        jfes_status_t status = jfes_cursor_move(cursor, 0);
+        if (jfes_status_is_bad(status)) {
+            return status;
+        }
+    }
+
+    if (cursor->event != jfes_sax_start_object && cursor->event != jfes_sax_start_array) {
+        return jfes_success;
+    }
+
+    if (cursor->tokens) {
+        const jfes_token_t *container = &cursor->tokens[cursor->container];
+        cursor->pos = jfes_skip_token(cursor->tokens, cursor->tokens_count, (jfes_size_t)cursor->container);
+        cursor->event = container->type == jfes_type_object ? jfes_sax_end_object : jfes_sax_end_array;
+        cursor->container = jfes_get_container(cursor->tokens, container->parent);
+        cursor->depth--;
+        return jfes_success;
+    }
+
+    /* Only brackets out of strings matter, nested primitives are not checked. */
+    const char *json = cursor->json;
+    jfes_size_t length = cursor->length;
+
+    jfes_size_t depth = 1;
+    int string = 0;                     /* Non-zero inside a string split by the window end. */
+    unsigned int escape = 0;
+    jfes_size_t pos = cursor->pos;
+    while (depth > 0) {
+        if (pos >= length) {
+            /* Nothing is kept: the skipped data is not needed anymore. */
+            if (jfes_cursor_refill(cursor, length) != jfes_success) {
+                return jfes_error_part;
+            }
+            pos = 0;
+            length = cursor->length;
+        }
+
+        if (string) {
+            /* Strings are scanned as jfes_cursor_move does, so both reject the same data. */
+            jfes_size_t end = length;
+            jfes_status_t status = jfes_scan_string(json, pos, length, &end, &escape);
+            if (jfes_status_is_bad(status)) {
+                return status;
+            }
+            string = end == length;
+            pos = string ? length : end + 1;
+            continue;
+        }
+
+        for (; pos < length; pos++) {
+            const char c = json[pos];
+            if (c == '\"') {
+                string = 1;
+                pos++;
+                break;
+            }
+            else if (c == '{' || c == '[') {
+                depth++;
+            }
+            else if ((c == '}' || c == ']') && --depth == 0) {
+                break;
+            }
+            else if (c == '\0') {
+                return jfes_error_part;
+            }
+        }
+    }
+
+    cursor->depth--;
+    cursor->expect_key = 0;
+    cursor->event = jfes_is_object_level(cursor->levels, cursor->depth) ? jfes_sax_end_object : jfes_sax_end_array;
+    cursor->pos = pos + 1;
+    return jfes_success;
+}
+
+jfes_status_t jfes_cursor_enter(jfes_cursor_t *cursor) {
+    if (!cursor) {
+        return jfes_invalid_arguments;
+    }
+
+    if (cursor->event != jfes_sax_start_object && cursor->event != jfes_sax_start_array) {
+        return jfes_wrong_type;
+    }
+
+    jfes_status_t status = jfes_cursor_next(cursor);
+    if (jfes_status_is_good(status) &&
+        (cursor->event == jfes_sax_end_object || cursor->event == jfes_sax_end_array)) {
+        return jfes_not_found;
+    }
+
+    return status;
+}
+
+jfes_status_t jfes_cursor_find(jfes_cursor_t *cursor, const char *key, jfes_size_t key_length) {
+    if (!cursor || !key) {
+        return jfes_invalid_arguments;
+    }
+
+    if (cursor->event != jfes_sax_start_object) {
+        return jfes_wrong_type;
+    }
+
+    if (key_length == 0) {
+        key_length = jfes_strlen(key);
+    }
+
+    jfes_status_t status = jfes_cursor_enter(cursor);
+    while (jfes_status_is_good(status)) {
+        if (cursor->event == jfes_sax_key && cursor->value.length == key_length && jfes_memcmp(cursor->value.data, key, key_length) == 0) {
+            return jfes_cursor_next(cursor);
+        }
+
+        status = jfes_cursor_skip(cursor);
+        if (jfes_status_is_good(status)) {
+            status = jfes_cursor_next(cursor);
+        }
+        if (jfes_status_is_good(status) && cursor->event == jfes_sax_end_object) {
+            return jfes_not_found;
+        }
+    }
+
+    return status;
+}
+
+jfes_status_t jfes_init_matcher(jfes_matcher_t *matcher, jfes_path_node_t *nodes, jfes_size_t max_nodes_count) {
+    if (!matcher || !nodes || max_nodes_count == 0) {
+        return jfes_invalid_arguments;
+    }
+
+    matcher->nodes = nodes;
+    matcher->nodes_count = 1;
+    matcher->max_nodes_count = max_nodes_count;
+    matcher->paths_count = 0;
+
+    nodes[0].reference = JFES_NULL;
+    nodes[0].reference_length = 0;
+    nodes[0].index = -1;
+    nodes[0].first_child = -1;
+    nodes[0].next = -1;
+    nodes[0].path = -1;
+
+    return jfes_success;
+}
+
+jfes_status_t jfes_matcher_add(jfes_matcher_t *matcher, const char *pointer, jfes_size_t pointer_length,
+        jfes_size_t *path) {
+    if (!matcher || !pointer) {
+        return jfes_invalid_arguments;
+    }
+
+    if (pointer_length == 0) {
+        pointer_length = jfes_strlen(pointer);
+    }
+
+    jfes_path_node_t *nodes = matcher->nodes;
+    int current = 0;
+    jfes_size_t pos = 0;
+    while (pos < pointer_length) {
+        if (pointer[pos] != '/') {
+            return jfes_invalid_arguments;
+        }
+
+        const char *reference = pointer + ++pos;
+        while (pos < pointer_length && pointer[pos] != '/') {
+            pos++;
+        }
+        const jfes_size_t reference_length = (jfes_size_t)(pointer + pos - reference);
+        if (!jfes_pointer_reference_is_valid(reference, reference_length)) {
+            return jfes_invalid_arguments;
+        }
+
+        int child = nodes[current].first_child;
+        int last = -1;
+        while (child != -1 && (nodes[child].reference_length != reference_length ||
+                jfes_memcmp(nodes[child].reference, reference, reference_length) != 0)) {
+            last = child;
+            child = nodes[child].next;
+        }
+
+        if (child == -1) {
+            if (matcher->nodes_count >= matcher->max_nodes_count) {
+                return jfes_no_memory;
+            }
+
+            child = (int)matcher->nodes_count++;
+            nodes[child].reference = reference;
+            nodes[child].reference_length = reference_length;
+            nodes[child].index = jfes_pointer_reference_index(reference, reference_length);
+            nodes[child].first_child = -1;
+            nodes[child].next = -1;
+            nodes[child].path = -1;
+
+            if (last == -1) {
+                nodes[current].first_child = child;
+            }
+            else {
+                nodes[last].next = child;
+            }
+        }
+        current = child;
+    }
+
+    if (nodes[current].path == -1) {
+        nodes[current].path = (int)matcher->paths_count++;
+    }
+
+    if (path) {
+        *path = (jfes_size_t)nodes[current].path;
+    }
+    return jfes_success;
+}
+
+/**
+    Collects the child nodes of the states which match the key or the index.
+
+    \param[in]      matcher             Pointer to the jfes_matcher_t object.
+    \param[in, out] states              Matching states. The children are added after `end`.
+    \param[in]      begin               First state of the current level.
+    \param[in]      end                 End of the current level states.
+    \param[in]      key                 Object key or JFES_NULL for the array item.
+    \param[in]      key_length          Object key length.
+    \param[in]      index               Array item index.
+
+    \return         End of the child level states.
+*/
+static jfes_size_t jfes_match_children(const jfes_matcher_t *matcher, int *states, jfes_size_t begin,
+        jfes_size_t end, const char *key, jfes_size_t key_length, int index) {
+    const jfes_path_node_t *nodes = matcher->nodes;
+
+    jfes_size_t children_end = end;
+    for (jfes_size_t i = begin; i < end; i++) {
+        for (int child = nodes[states[i]].first_child; child != -1; child = nodes[child].next) {
+            const jfes_path_node_t *node = &nodes[child];
+            int matched = node->reference_length == 1 && node->reference[0] == '*';
+            if (!matched && key) {
+                matched = jfes_pointer_reference_equals(node->reference, node->reference_length, key, key_length);
+            }
+            else if (!matched) {
+                matched = node->index == index;
+            }
+
+            if (matched) {
+                states[children_end++] = child;
+            }
+        }
+    }
+
+    return children_end;
+}
+
+/**
+    Matches the value at the cursor against the states and reads it to its end.
+    Every node is at most once in the states, so they fit in `matcher->nodes_count` items.
+
+    \param[in]      matcher             Pointer to the jfes_matcher_t object.
+    \param[in, out] cursor              Cursor at the first event of the value.
+    \param[in, out] states              Matching states.
+    \param[in]      begin               First state of the value.
+    \param[in]      end                 End of the value states.
+    \param[in]      callback            Callback for the matches.
+    \param[in]      context             User data for the callback.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_match_value(const jfes_matcher_t *matcher, jfes_cursor_t *cursor, int *states,
+        jfes_size_t begin, jfes_size_t end, jfes_match_callback_t callback, void *context) {
+    const jfes_path_node_t *nodes = matcher->nodes;
+
+    int has_children = 0;
+    int decoded = 0;
+    for (jfes_size_t i = begin; i < end; i++) {
+        const jfes_path_node_t *node = &nodes[states[i]];
+        if (node->path != -1) {
+            /* Only the matched values are decoded. */
+            if (!decoded) {
+                jfes_status_t status = jfes_cursor_decode(cursor);
+                if (jfes_status_is_bad(status)) {
+                    return status;
+                }
+                decoded = 1;
+            }
+
+            if (!callback(context, (jfes_size_t)node->path, cursor)) {
+                return jfes_stopped;
+            }
+        }
+        has_children = has_children || node->first_child != -1;
+    }
+
+    if (cursor->event != jfes_sax_start_object && cursor->event != jfes_sax_start_array) {
+        return jfes_success;
+    }
+    if (!has_children) {
+        return jfes_cursor_skip(cursor);
+    }
+
+    int index = 0;
+    for (;; index++) {
+        jfes_status_t status = jfes_cursor_move(cursor, 0);
+        if (jfes_status_is_bad(status)) {
+            return status == jfes_not_found ? jfes_error_part : status;
+        }
+        if (cursor->event == jfes_sax_end_object || cursor->event == jfes_sax_end_array) {
+            return jfes_success;
+        }
+
+        /* The key must be matched before the next event: the reader cursor may drop it. */
+        jfes_size_t children_end = end;
+        if (cursor->event == jfes_sax_key) {
+            children_end = jfes_match_children(matcher, states, begin, end, cursor->value.data, cursor->value.length, -1);
+            if (children_end == end) {
+                status = jfes_cursor_skip(cursor);
+            }
+            else {
+                status = jfes_cursor_move(cursor, 0);
+            }
+        }
+        else {
+            children_end = jfes_match_children(matcher, states, begin, end, JFES_NULL, 0, index);
+            if (children_end == end) {
+                status = jfes_cursor_skip(cursor);
+            }
+        }
+
+        if (jfes_status_is_good(status) && children_end > end) {
+            status = jfes_match_value(matcher, cursor, states, end, children_end, callback, context);
+        }
+        if (jfes_status_is_bad(status)) {
+            return status == jfes_not_found ? jfes_error_part : status;
+        }
+    }
+}
+
+jfes_status_t jfes_match(const jfes_matcher_t *matcher, jfes_cursor_t *cursor, int *states,
+        jfes_match_callback_t callback, void *context) {
+    if (!matcher || !cursor || !states || !callback) {
+        return jfes_invalid_arguments;
+    }
+
+    jfes_status_t status = jfes_cursor_move(cursor, 0);
+    if (jfes_status_is_bad(status)) {
+        return status;
+    }
+    if (cursor->event == jfes_sax_end_object || cursor->event == jfes_sax_end_array || cursor->event == jfes_sax_key) {
+        return jfes_invalid_input;
+    }
+
+    states[0] = 0;
+    return jfes_match_value(matcher, cursor, states, 0, 1, callback, context);
+}
+
+/**
+    Finds the field by the object key.
+
+    \param[in]      fields              Fields table.
+    \param[in]      key                 Object key.
+    \param[in]      key_length          Object key length.
+
+    \return         Found field or JFES_NULL.
+*/
+static const jfes_field_t *jfes_find_field(const jfes_field_t *fields, const char *key, jfes_size_t key_length) {
+    /* jfes_memcmp stops at the first difference, so names shorter than the key are not overrun. */
+    for (; fields->name; fields++) {
+        if (jfes_memcmp(fields->name, key, key_length) == 0 && fields->name[key_length] == '\0') {
+            return fields;
+        }
+    }
+
+    return JFES_NULL;
+}
+
+/**
+    Returns the size of the field value: the array item stride.
+
+    \param[in]      field               Field descriptor.
+
+    \return         Field value size.
+*/
+static jfes_size_t jfes_field_size(const jfes_field_t *field) {
+    switch (field->type) {
+    case jfes_field_boolean:
+        return sizeof(int);
+
+    case jfes_field_integer:
+        return sizeof(jfes_integer_t);
+
+    case jfes_field_double:
+        return sizeof(double);
+
+    default:
+        return field->size;
+    }
+}
+
+static jfes_status_t jfes_read_fields(jfes_cursor_t *cursor, const jfes_field_t *fields, char *data);
+
+/**
+    Writes the value at the cursor into the field.
+
+    \param[in, out] cursor              Cursor at the first event of the value.
+    \param[in]      field               Field descriptor.
+    \param[out]     target              Pointer to the field value.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_read_field_value(jfes_cursor_t *cursor, const jfes_field_t *field, char *target) {
+    const jfes_sax_value_t *value = &cursor->value;
+    if (field->type == jfes_field_object) {
+        if (cursor->event != jfes_sax_start_object) {
+            return jfes_wrong_type;
+        }
+        return jfes_read_fields(cursor, field->fields, target);
+    }
+
+    if (cursor->event != jfes_sax_value) {
+        return jfes_wrong_type;
+    }
+
+    switch (field->type) {
+    case jfes_field_boolean:
+        if (value->type != jfes_type_boolean) {
+            return jfes_wrong_type;
+        }
+        *(int*)target = value->value.bool_val;
+        break;
+
+    case jfes_field_integer:
+        if (value->type != jfes_type_integer) {
+            return jfes_wrong_type;
+        }
+        *(jfes_integer_t*)target = value->value.int_val;
+        break;
+
+    case jfes_field_double:
+        if (value->type == jfes_type_integer) {
+            *(double*)target = (double)value->value.int_val;
+        }
+        else if (value->type == jfes_type_double) {
+            *(double*)target = value->value.double_val;
+        }
+        else {
+            return jfes_wrong_type;
+        }
+        break;
+
+    case jfes_field_string:
+        if (value->type != jfes_type_string) {
+            return jfes_wrong_type;
+        }
+        /* The decoded string is never longer, so the length pass is needed only for the long ones. */
+        if (value->length >= field->size && jfes_decoded_length(value->data, value->length) >= field->size) {
+            return jfes_no_memory;
+        }
+        target[jfes_decode_string(target, value->data, value->length)] = '\0';
+        break;
+
+    default:
+        return jfes_invalid_arguments;
+    }
+
+    return jfes_success;
+}
+
+/**
+    Reads the array at the cursor into the array field.
+
+    \param[in, out] cursor              Cursor at the array start.
+    \param[in]      field               Field descriptor.
+    \param[out]     data                Pointer to the struct with the field.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_read_field_array(jfes_cursor_t *cursor, const jfes_field_t *field, char *data) {
+    if (cursor->event != jfes_sax_start_array) {
+        return jfes_wrong_type;
+    }
+
+    const jfes_size_t stride = jfes_field_size(field);
+    jfes_size_t count = 0;
+    for (;;) {
+        jfes_status_t status = jfes_cursor_next(cursor);
+        if (jfes_status_is_bad(status)) {
+            return status == jfes_not_found ? jfes_error_part : status;
+        }
+        if (cursor->event == jfes_sax_end_array) {
+            break;
+        }
+        if (count >= field->capacity) {
+            return jfes_no_memory;
+        }
+
+        /* Null items are counted but left as they are. */
+        if (cursor->event != jfes_sax_value || cursor->value.type != jfes_type_null) {
+            status = jfes_read_field_value(cursor, field, data + field->offset + count * stride);
+        }
+        if (jfes_status_is_bad(status)) {
+            return status;
+        }
+        count++;
+    }
+
+    *(jfes_size_t*)(data + field->count_offset) = count;
+    return jfes_success;
+}
+
+/**
+    Reads the object at the cursor into the struct.
+
+    \param[in, out] cursor              Cursor at the object start.
+    \param[in]      fields              Fields table of the struct.
+    \param[out]     data                Pointer to the struct.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_read_fields(jfes_cursor_t *cursor, const jfes_field_t *fields, char *data) {
+    for (;;) {
+        jfes_status_t status = jfes_cursor_move(cursor, 0);
+        if (jfes_status_is_bad(status)) {
+            return status == jfes_not_found ? jfes_error_part : status;
+        }
+        if (cursor->event == jfes_sax_end_object) {
+            return jfes_success;
+        }
+        if (cursor->event != jfes_sax_key) {
+            return jfes_invalid_input;
+        }
+
+        /* The key must be looked up before the next event: the reader cursor may drop it. */
+        const jfes_field_t *field = jfes_find_field(fields, cursor->value.data, cursor->value.length);
+        if (!field) {
+            status = jfes_cursor_skip(cursor);
+            if (jfes_status_is_bad(status)) {
+                return status;
+            }
+            continue;
+        }
+
+        status = jfes_cursor_next(cursor);
+        if (jfes_status_is_good(status) && cursor->event == jfes_sax_value && cursor->value.type == jfes_type_null) {
+            continue;
+        }
+        if (jfes_status_is_good(status)) {
+            status = field->capacity > 0 ? jfes_read_field_array(cursor, field, data) :
+                jfes_read_field_value(cursor, field, data + field->offset);
+        }
+        if (jfes_status_is_bad(status)) {
+            return status == jfes_not_found ? jfes_error_part : status;
+        }
+    }
+}
+
+jfes_status_t jfes_read_struct(jfes_cursor_t *cursor, const jfes_field_t *fields, void *data) {
+    if (!cursor || !fields || !data) {
+        return jfes_invalid_arguments;
+    }
+
+    jfes_status_t status = jfes_cursor_move(cursor, 0);
+    if (jfes_status_is_bad(status)) {
+        return status;
+    }
+    if (cursor->event != jfes_sax_start_object) {
+        return jfes_wrong_type;
+    }
+
+    return jfes_read_fields(cursor, fields, (char*)data);
+}
+
+/**
+    Creates jfes value node from the tokens sequence.
+
+    \param[in]      tokens_data         Pointer to the jfes_tokens_data_t object.
+    \param[in, out] in_situ_data        Writable JSON data for the in-situ strings or JFES_NULL.
+    \param[out]     value               Pointer to the value to create node.
+
+    \return         jfes_success if everything is OK. Otherwise the node is freed and left null.
+*/
+static jfes_status_t jfes_create_node(jfes_tokens_data_t *tokens_data, char *in_situ_data, jfes_value_t *value) {
+    if (!tokens_data || !value) {
+        return jfes_invalid_arguments;
+    }
+
+    if (tokens_data->current_token >= tokens_data->tokens_count) {
+        value->type = jfes_type_null;
+        return jfes_invalid_arguments;
+    }
+
+    jfes_malloc_t jfes_malloc = tokens_data->config->jfes_malloc;
+    jfes_free_t   jfes_free   = tokens_data->config->jfes_free;
+
+    jfes_token_t *token = &tokens_data->tokens[tokens_data->current_token];
+    tokens_data->current_token++;
+
+    jfes_status_t status = jfes_success;
+    value->type = token->type;
+
+    switch (token->type) {
+    case jfes_type_null:
+        break;
+
+    case jfes_type_boolean:
+    case jfes_type_integer:
+    case jfes_type_double:
+        {
+            jfes_token_value_t token_value;
+            jfes_get_token_value(tokens_data->json_data, token, &token_value);
+
+            if (token->type == jfes_type_boolean) {
+                value->data.bool_val = token_value.bool_val;
+            }
+            else if (token->type == jfes_type_integer) {
+                value->data.int_val = token_value.int_val;
+            }
+            else {
+                value->data.double_val = token_value.double_val;
+            }
+        }
+        break;
+
+    case jfes_type_string:
+        status = jfes_create_token_string(tokens_data, in_situ_data, &value->data.string_val, token);
+        break;
+
+    case jfes_type_array:
+        value->data.array_val = (jfes_array_t*)jfes_malloc(sizeof(jfes_array_t));
+        if (!value->data.array_val) {
+            value->type = jfes_type_null;
+            status = jfes_no_memory;
+            break;
+        }
+        value->data.array_val->count = 0;
+        value->data.array_val->items = JFES_NULL;
+
+        if (token->size > 0) {
+            value->data.array_val->items = (jfes_value_t**)jfes_malloc(token->size * sizeof(jfes_value_t*));
+            if (!value->data.array_val->items) {
+                jfes_free(value->data.array_val);
+                value->type = jfes_type_null;
+                status = jfes_no_memory;
+                break;
+            }
+
+            for (jfes_size_t i = 0; i < token->size && jfes_status_is_good(status); i++) {
+                jfes_value_t *item = (jfes_value_t*)jfes_malloc(sizeof(jfes_value_t));
+                if (!item) {
+                    status = jfes_no_memory;
+                    break;
+                }
+                value->data.array_val->items[i] = item;
+                value->data.array_val->count = i + 1;
+
+                status = jfes_create_node(tokens_data, in_situ_data, item);
+            }
+
+            if (jfes_status_is_bad(status) && value->data.array_val->count == 0) {
+                jfes_free(value->data.array_val->items);
+            }
+        }
+        break;
+
+    case jfes_type_object:
+        value->data.object_val = (jfes_object_t*)jfes_malloc(sizeof(jfes_object_t));
+        if (!value->data.object_val) {
+            value->type = jfes_type_null;
+            status = jfes_no_memory;
+            break;
+        }
+        value->data.object_val->count = 0;
+        value->data.object_val->items = JFES_NULL;
+
+        if (token->size > 0) {
+            value->data.object_val->items = (jfes_object_map_t**)jfes_malloc(token->size * sizeof(jfes_object_map_t*));
+            if (!value->data.object_val->items) {
+                jfes_free(value->data.object_val);
+                value->type = jfes_type_null;
+                status = jfes_no_memory;
+                break;
+            }
+
+            for (jfes_size_t i = 0; i < token->size && jfes_status_is_good(status); i++) {
+                jfes_object_map_t *item = (jfes_object_map_t*)jfes_malloc(sizeof(jfes_object_map_t));
+                if (!item) {
+                    status = jfes_no_memory;
+                    break;
+                }
+
+                jfes_token_t *key_token = &tokens_data->tokens[tokens_data->current_token++];
+                status = jfes_create_token_string(tokens_data, in_situ_data, &item->key, key_token);
+                if (jfes_status_is_bad(status)) {
+                    jfes_free(item);
+                    break;
+                }
+
+                item->value = (jfes_value_t*)jfes_malloc(sizeof(jfes_value_t));
+                if (!item->value) {
+                    jfes_free_string(tokens_data->config, &item->key);
+                    jfes_free(item);
+                    status = jfes_no_memory;
+                    break;
+                }
+                value->data.object_val->items[i] = item;
+                value->data.object_val->count = i + 1;
+
+                status = jfes_create_node(tokens_data, in_situ_data, item->value);
+            }
+
+            if (jfes_status_is_bad(status) && value->data.object_val->count == 0) {
+                jfes_free(value->data.object_val->items);
+            }
+        }
+        break;
+
+    default:
+        value->type = jfes_type_null;
+        status = jfes_unknown_type;
+        break;
+    }
+
+    if (jfes_status_is_bad(status)) {
+        /* Failed items are left null, so the counted ones are freed with the node. */
+        jfes_free_value(tokens_data->config, value);
+        value->type = jfes_type_null;
+    }
+    return status;
+}
+
+/**
+    Parses JSON data string into tokens, growing the tokens array when it's full.
+    Already parsed tokens are kept, so the data is scanned only once.
+
+    \param[in, out] parser              Pointer to the jfes_parser_t object.
+    \param[in]      json                JSON data string.
+    \param[in]      length              JSON data length.
+    \param[in, out] tokens              Tokens array allocated by the parser configuration.
+                                        Can be JFES_NULL. Will be reallocated if needed.
+    \param[in, out] capacity            Tokens array capacity.
+    \param[out]     tokens_count        Parsed tokens count.
+
+    \return         jfes_success if everything is OK.
+*/
+static jfes_status_t jfes_parse_tokens_growing(jfes_parser_t *parser, const char *json, jfes_size_t length,
+        jfes_token_t **tokens, jfes_size_t *capacity, jfes_size_t *tokens_count) {
+    const jfes_config_t *config = parser->config;
+
+    jfes_reset_parser(parser);
+
+    if (!*tokens || *capacity == 0) {
+        *capacity = 1024;
+        *tokens = (jfes_token_t*)config->jfes_malloc(*capacity * sizeof(jfes_token_t));
+        if (!*tokens) {
+            *capacity = 0;
+            return jfes_no_memory;
+        }
     }
 
-    if (data_length == 0) {
-        data_length = jfes_strlen(data);
-    }
-    jfes_status_t status = jfes_success;
+    for (;;) {
+        *tokens_count = *capacity;
+        jfes_status_t status = jfes_parse_tokens_helper(parser, json, length, *tokens, tokens_count, 0);
+        if (status != jfes_no_memory) {
+            return status;
+        }
 
-    jfes_size_t size_to_add = data_length;
-    
-    if (stream->current_index + size_to_add > stream->max_size) {
-        size_to_add = stream->max_size - stream->current_index;
-        status = jfes_no_memory;
-    }
+        if (*capacity > ((jfes_size_t)-1) / (2 * sizeof(jfes_token_t))) {
+            return jfes_no_memory;
+        }
 
-    jfes_memcpy(stream->data + stream->current_index, data, size_to_add);
+        jfes_token_t *new_tokens = (jfes_token_t*)config->jfes_malloc(*capacity * 2 * sizeof(jfes_token_t));
+        if (!new_tokens) {
+            return jfes_no_memory;
+        }
 
-    stream->current_index += size_to_add;
-    return status;
+        jfes_memcpy(new_tokens, *tokens, parser->next_token * sizeof(jfes_token_t));
+        config->jfes_free(*tokens);
+
+        *tokens = new_tokens;
+        *capacity *= 2;
+    }
 }
 
 /**
-    Allocates a fresh unused token from the token pool.
+    Checks if any of the matcher states is at the end of a path.
 
-    \param[in, out] parser              Pointer to the jfes_parser_t object.
-    \param[in, out] tokens              Tokens array.
-    \param[in]      max_tokens          Maximal tokens count.
+    \param[in]      matcher             Pointer to the jfes_matcher_t object.
+    \param[in]      states              Matching states.
+    \param[in]      begin               First state to check.
+    \param[in]      end                 End of the states to check.
 
-    \return         Pointer to the allocated token from the token pool.
+    \return         Non-zero if a path ends at the states.
 */
-static jfes_token_t *jfes_allocate_token(jfes_parser_t *parser, jfes_token_t *tokens, jfes_size_t max_tokens) {
-    if (!parser || !tokens || max_tokens == 0 || parser->next_token >= max_tokens) {
-        return JFES_NULL;
+static int jfes_is_path_end(const jfes_matcher_t *matcher, const int *states, jfes_size_t begin, jfes_size_t end) {
+    for (jfes_size_t i = begin; i < end; i++) {
+        if (matcher->nodes[states[i]].path != -1) {
+            return 1;
+        }
     }
-    
-    jfes_token_t *token = &tokens[parser->next_token++];
-    token->start = token->end = -1;
-    token->size = 0;
+    return 0;
+}
 
-    return token;
+/**
+    Finds the matcher states of the container child and decides if it is projected:
+    a path ends at it or leads into its nested values.
+
+    \param[in]      tokens_data         Tokens of the parsed JSON data.
+    \param[in]      matcher             Pointer to the jfes_matcher_t object.
+    \param[in, out] states              Matching states. The child states are added after `end`.
+    \param[in]      begin               First state of the container.
+    \param[in]      end                 End of the container states.
+    \param[in]      child               Index of the child token: object key or array item.
+    \param[in]      index               Index of the child in the container.
+
+    \return         End of the child states. `end` if the child is not projected.
+*/
+static jfes_size_t jfes_project_child(const jfes_tokens_data_t *tokens_data, const jfes_matcher_t *matcher,
+        int *states, jfes_size_t begin, jfes_size_t end, jfes_size_t child, jfes_size_t index) {
+    const jfes_token_t *tokens = tokens_data->tokens;
+    const jfes_token_t *token = &tokens[child];
+
+    const int key = tokens[token->parent].type == jfes_type_object;
+    const jfes_size_t children_end = key ?
+        jfes_match_children(matcher, states, begin, end, tokens_data->json_data + token->start,
+            (jfes_size_t)(token->end - token->start), -1) :
+        jfes_match_children(matcher, states, begin, end, JFES_NULL, 0, (int)index);
+
+    const jfes_size_t value_index = key ? child + 1 : child;
+    if (value_index >= tokens_data->tokens_count) {
+        return end;
+    }
+
+    /* Paths can't lead into primitives. */
+    const jfes_token_type_t type = tokens[value_index].type;
+    if (type == jfes_type_array || type == jfes_type_object ||
+            jfes_is_path_end(matcher, states, end, children_end)) {
+        return children_end;
+    }
+    return end;
 }
 
-/** 
-    Analyzes the source string and returns most likely type.
+/**
+    Creates jfes value node from the tokens sequence only with the subtrees
+    which the matcher paths lead into. Other subtrees are skipped by tokens.
 
-    \param[in]      data                Source string bytes.
-    \param[in]      length              Source string length.
+    \param[in]      tokens_data         Pointer to the jfes_tokens_data_t object.
+    \param[in, out] in_situ_data        Writable JSON data for the in-situ strings or JFES_NULL.
+    \param[in]      matcher             Pointer to the jfes_matcher_t object.
+    \param[in, out] states              Matching states.
+    \param[in]      begin               First state of the value.
+    \param[in]      end                 End of the value states.
+    \param[out]     value               Pointer to the value to create node.
 
-    \return         Most likely token type or `jfes_type_undefined`.
+    \return         jfes_success if everything is OK.
 */
-static jfes_token_type_t jfes_get_token_type(const char *data, jfes_size_t length) {
-    if (!data || length == 0) {
-        return jfes_type_undefined;
+static jfes_status_t jfes_create_projected_node(jfes_tokens_data_t *tokens_data, char *in_situ_data,
+        const jfes_matcher_t *matcher, int *states, jfes_size_t begin, jfes_size_t end, jfes_value_t *value) {
+    if (jfes_is_path_end(matcher, states, begin, end)) {
+        return jfes_create_node(tokens_data, in_situ_data, value);
     }
 
-    if (jfes_is_null(data, length)) {
-        return jfes_type_null;
+    const jfes_token_t *tokens = tokens_data->tokens;
+    const jfes_size_t tokens_count = tokens_data->tokens_count;
+    const jfes_size_t index = tokens_data->current_token;
+    const jfes_token_t *token = &tokens[index];
+    if (token->type != jfes_type_array && token->type != jfes_type_object) {
+        return jfes_not_found;
     }
-    else if (jfes_is_boolean(data, length)) {
-        return jfes_type_boolean;
+
+    jfes_malloc_t jfes_malloc = tokens_data->config->jfes_malloc;
+    jfes_free_t   jfes_free   = tokens_data->config->jfes_free;
+
+    /* The first pass counts the projected children to allocate them at once.
+       It is an upper bound: containers with no path ending inside are dropped by the second pass. */
+    jfes_size_t count = 0;
+    jfes_size_t child = index + 1;
+    for (jfes_size_t i = 0; i < token->size && child < tokens_count; i++) {
+        if (jfes_project_child(tokens_data, matcher, states, begin, end, child, i) > end) {
+            count++;
+        }
+        child = jfes_skip_token(tokens, tokens_count, child);
     }
-    else if (jfes_is_integer(data, length)) {
-        return jfes_type_integer;
+
+    /* Containers are built as empty ones, so jfes_free_value can clean them up at any moment. */
+    value->type = token->type;
+    void **items = JFES_NULL;
+    if (token->type == jfes_type_array) {
+        value->data.array_val = (jfes_array_t*)jfes_malloc(sizeof(jfes_array_t));
+        if (!value->data.array_val) {
+            return jfes_no_memory;
+        }
+        value->data.array_val->count = 0;
+        value->data.array_val->items = JFES_NULL;
+        if (count > 0) {
+            value->data.array_val->items = (jfes_value_t**)jfes_malloc(count * sizeof(jfes_value_t*));
+            items = (void**)value->data.array_val->items;
+        }
     }
-    else if (jfes_is_double(data, length)) {
-        return jfes_type_double;
+    else {
+        value->data.object_val = (jfes_object_t*)jfes_malloc(sizeof(jfes_object_t));
+        if (!value->data.object_val) {
+            return jfes_no_memory;
+        }
+        value->data.object_val->count = 0;
+        value->data.object_val->items = JFES_NULL;
+        if (count > 0) {
+            value->data.object_val->items = (jfes_object_map_t**)jfes_malloc(count * sizeof(jfes_object_map_t*));
+            items = (void**)value->data.object_val->items;
+        }
     }
 
-    return jfes_type_undefined;
-}
+    jfes_status_t status = count > 0 && !items ? jfes_no_memory : jfes_success;
+    jfes_size_t created = 0;
+    child = index + 1;
+    for (jfes_size_t i = 0; i < token->size && child < tokens_count && jfes_status_is_good(status); i++) {
+        const jfes_size_t next = jfes_skip_token(tokens, tokens_count, child);
+        const jfes_size_t children_end = jfes_project_child(tokens_data, matcher, states, begin, end, child, i);
+        if (children_end == end) {
+            child = next;
+            continue;
+        }
 
-/**
-    Fills token type and boundaries.
+        jfes_value_t *item = (jfes_value_t*)jfes_malloc(sizeof(jfes_value_t));
+        if (!item) {
+            status = jfes_no_memory;
+            break;
+        }
+        item->type = jfes_type_null;
 
-    \param[in, out] token               Pointer to the token to fill.
-    \param[in]      type                Token type.
-    \param[in]      start               Token boundary start.
-    \param[in]      end                 Token boundary end.
-*/
-static void jfes_fill_token(jfes_token_t *token, jfes_token_type_t type, int start, int end) {
-    if (token) {
-        token->type = type;
-        token->start = start;
-        token->end = end;
-        token->size = 0;
+        if (token->type == jfes_type_array) {
+            value->data.array_val->items[created] = item;
+            value->data.array_val->count = ++created;
+            tokens_data->current_token = child;
+        }
+        else {
+            jfes_object_map_t *object_map = (jfes_object_map_t*)jfes_malloc(sizeof(jfes_object_map_t));
+            if (!object_map) {
+                jfes_free(item);
+                status = jfes_no_memory;
+                break;
+            }
+            object_map->value = item;
+            status = jfes_create_token_string(tokens_data, in_situ_data, &object_map->key, &tokens[child]);
+            if (jfes_status_is_bad(status)) {
+                jfes_free(item);
+                jfes_free(object_map);
+                break;
+            }
+
+            value->data.object_val->items[created] = object_map;
+            value->data.object_val->count = ++created;
+            tokens_data->current_token = child + 1;
+        }
+
+        status = jfes_create_projected_node(tokens_data, in_situ_data, matcher, states, end, children_end, item);
+        if (jfes_status_is_bad(status)) {
+            /* The failed node has cleaned itself up. */
+            item->type = jfes_type_null;
+        }
+        else if (!jfes_is_path_end(matcher, states, end, children_end) &&
+                (item->type == jfes_type_array ? item->data.array_val->count : item->data.object_val->count) == 0) {
+            /* No path ends inside the child: it is neither matched nor a parent of a match. */
+            jfes_free_value(tokens_data->config, item);
+            jfes_free(item);
+            created--;
+            if (token->type == jfes_type_array) {
+                value->data.array_val->count = created;
+            }
+            else {
+                jfes_free_string(tokens_data->config, &value->data.object_val->items[created]->key);
+                jfes_free(value->data.object_val->items[created]);
+                value->data.object_val->count = created;
+            }
+        }
+        child = next;
+    }
+
+    /* jfes_free_value frees the items array only if there are items. */
+    if (created == 0 && items) {
+        jfes_free(items);
+        items = JFES_NULL;
+        if (token->type == jfes_type_array) {
+            value->data.array_val->items = JFES_NULL;
+        }
+        else {
+            value->data.object_val->items = JFES_NULL;
+        }
+    }
+
+    if (jfes_status_is_bad(status)) {
+        jfes_free_value(tokens_data->config, value);
+        return status;
     }
+
+    tokens_data->current_token = jfes_skip_token(tokens, tokens_count, index);
+    return jfes_success;
 }
 
 /**
-    Fills next available token with JSON primitive.
+    Parses JSON data string into the value with the given tokens array.
+    The tokens array is kept for the next calls.
 
     \param[in, out] parser              Pointer to the jfes_parser_t object.
     \param[in]      json                JSON data string.
     \param[in]      length              JSON data length.
-    \param[out]     tokens              Tokens array to fill.
-    \param[in]      max_tokens_count    Maximal count of tokens in tokens array.
+    \param[in, out] tokens              Tokens array allocated by the parser configuration.
+                                        Can be JFES_NULL. Will be reallocated if needed.
+    \param[in, out] capacity            Tokens array capacity.
+    \param[in, out] in_situ_data        Writable JSON data for the in-situ strings or JFES_NULL.
+    \param[out]     value               Output value.
 
     \return         jfes_success if everything is OK.
 */
-static jfes_status_t jfes_parse_primitive(jfes_parser_t *parser, const char *json, jfes_size_t length,
-        jfes_token_t *tokens, jfes_size_t max_tokens_count) {
-    if (!parser || !json || length == 0 || !tokens || max_tokens_count == 0) {
-        return jfes_invalid_arguments;
-    }
-
-    int found = 0;
-
-    jfes_size_t start = parser->pos;
-    while (length && json[parser->pos] != '\0') {
-        char c = json[parser->pos];
-        if (c == '\t' || c == '\n' || c == '\r' || c == ' ' ||
-            c == ',' || c == ']' || c == '}'
-#ifndef JFES_STRICT
-            || c == ':'
-#endif
-            ) {
-            found = 1;
-            break;
-        }
-
-        parser->pos++;
-    }
+static jfes_status_t jfes_parse_to_value_reusing(jfes_parser_t *parser, const char *json, jfes_size_t length,
+        jfes_token_t **tokens, jfes_size_t *capacity, char *in_situ_data, jfes_value_t *value) {
+    jfes_size_t tokens_count = 0;
 
-#ifdef JFES_STRICT
-    if (!found) {
-        parser->pos = start;
-        return jfes_error_part;
+    jfes_status_t status = jfes_parse_tokens_growing(parser, json, length, tokens, capacity, &tokens_count);
+    if (jfes_status_is_bad(status)) {
+        return status;
     }
-#endif
 
-    jfes_token_t *token = jfes_allocate_token(parser, tokens, max_tokens_count);
-    if (!token) {
-        parser->pos = start;
-        return jfes_no_memory;
-    }
+    jfes_tokens_data_t tokens_data = { 0 };
+    tokens_data.config = parser->config;
 
-    jfes_size_t token_length = parser->pos - start;
-    jfes_token_type_t type = jfes_get_token_type(json + start, token_length);
+    tokens_data.json_data = json;
+    tokens_data.json_data_length = length;
 
-    jfes_fill_token(token, type, start, parser->pos);
-    parser->pos--;
+    tokens_data.tokens = *tokens;
+    tokens_data.tokens_count = tokens_count;
+    tokens_data.current_token = 0;
 
-    return jfes_success;
+    return jfes_create_node(&tokens_data, in_situ_data, value);
 }
 
 /**
-    Fills next available token with JSON string.
+    Parses JSON data string into the value with the temporary tokens array.
 
-    \param[in, out] parser              Pointer to the jfes_parser_t object.
+    \param[in]      config              JFES configuration.
     \param[in]      json                JSON data string.
     \param[in]      length              JSON data length.
-    \param[out]     tokens              Tokens array to fill.
-    \param[in]      max_tokens_count    Maximal count of tokens in tokens array.
+    \param[in, out] in_situ_data        Writable JSON data for the in-situ strings or JFES_NULL.
+    \param[out]     value               Output value.
 
     \return         jfes_success if everything is OK.
 */
-static jfes_status_t jfes_parse_string(jfes_parser_t *parser, const char *json, jfes_size_t length,
-        jfes_token_t *tokens, jfes_size_t max_tokens_count) {
-    if (!parser || !json || length == 0 || !tokens || max_tokens_count == 0) {
+static jfes_status_t jfes_parse_to_value_once(const jfes_config_t *config, const char *json,
+        jfes_size_t length, char *in_situ_data, jfes_value_t *value) {
+    if (!jfes_check_configuration(config) || !json || length == 0 || !value) {
         return jfes_invalid_arguments;
     }
 
-    jfes_size_t start = parser->pos++;
-    while (parser->pos < length && json[parser->pos] != '\0') {
-        char c = json[parser->pos];
-        if (c == '\"') {
-            jfes_token_t *token = jfes_allocate_token(parser, tokens, max_tokens_count);
-            if (!token) {
-                parser->pos = start;
-                return jfes_no_memory;
-            }
+    jfes_parser_t parser;
+    jfes_status_t status = jfes_init_parser(&parser, config);
+    if (jfes_status_is_bad(status)) {
+        return status;
+    }
 
-            jfes_fill_token(token, jfes_type_string, start + 1, parser->pos);
-            return jfes_success;
-        }
-        else if (c == '\\' && parser->pos + 1 < length) {
-            parser->pos++;
-            switch (json[parser->pos]) {
-            case '\"': case '/': case '\\': case 'b': case 'f':
-            case 'r': case 'n': case 't':
-                break;
+    jfes_token_t *tokens = JFES_NULL;
+    jfes_size_t capacity = 0;
 
-            case 'u':
-                parser->pos++;
-                for (jfes_size_t i = 0;  i < 4 && parser->pos < length && json[parser->pos] != '\0'; i++, parser->pos++) {
-                    char symbol = json[parser->pos];
-                    if ((symbol < (int)'0' || symbol > (int)'9') &&
-                        (symbol < (int)'A' || symbol > (int)'F') &&
-                        (symbol < (int)'a' || symbol > (int)'f')) {
-                        parser->pos = start;
-                        return jfes_invalid_input;
-                    }
-                }
-                parser->pos--;
-                break;
-            default:
-                parser->pos = start;
-                return jfes_invalid_input;
-            }
-        }
-        parser->pos++;
-    }
+    status = jfes_parse_to_value_reusing(&parser, json, length, &tokens, &capacity, in_situ_data, value);
 
-    parser->pos = start;
-    return jfes_error_part;
+    if (tokens) {
+        config->jfes_free(tokens);
+    }
+    return status;
 }
 
-int jfes_status_is_good(jfes_status_t status) {
-    return status == jfes_success;
+jfes_status_t jfes_parse_to_value(const jfes_config_t *config, const char *json,
+        jfes_size_t length, jfes_value_t *value) {
+    return jfes_parse_to_value_once(config, json, length, JFES_NULL, value);
 }
 
-int jfes_status_is_bad(jfes_status_t status) {
-    return !jfes_status_is_good(status);
+jfes_status_t jfes_parse_to_value_in_situ(const jfes_config_t *config, char *json,
+        jfes_size_t length, jfes_value_t *value) {
+    return jfes_parse_to_value_once(config, json, length, json, value);
 }
 
-jfes_status_t jfes_init_parser(jfes_parser_t *parser, const jfes_config_t *config) {
-    if (!parser || !config) {
+jfes_status_t jfes_parse_to_projected_value(const jfes_config_t *config, const char *json, jfes_size_t length,
+        const jfes_matcher_t *matcher, jfes_value_t *value) {
+    if (!jfes_check_configuration(config) || !json || length == 0 || !matcher || !value) {
         return jfes_invalid_arguments;
     }
 
-    parser->config = config;
-
-    return jfes_reset_parser(parser);
-}
-
-jfes_status_t jfes_reset_parser(jfes_parser_t *parser) {
-    if (!parser) {
-        return jfes_invalid_arguments;
+    jfes_parser_t parser;
+    jfes_status_t status = jfes_init_parser(&parser, config);
+    if (jfes_status_is_bad(status)) {
+        return status;
     }
 
-    parser->pos = 0;
-    parser->next_token = 0;
-    parser->superior_token = -1;
+    jfes_token_t *tokens = JFES_NULL;
+    jfes_size_t capacity = 0;
+    jfes_size_t tokens_count = 0;
 
-    return jfes_success;
-}
+    status = jfes_parse_tokens_growing(&parser, json, length, &tokens, &capacity, &tokens_count);
 
-jfes_status_t jfes_parse_tokens(jfes_parser_t *parser, const char *json,
-        jfes_size_t length, jfes_token_t *tokens, jfes_size_t *max_tokens_count) {
-    if (!parser || !json || length == 0 || !tokens || !max_tokens_count || *max_tokens_count == 0) {
-        return jfes_invalid_arguments;
+    int *states = JFES_NULL;
+    if (jfes_status_is_good(status)) {
+        states = (int*)config->jfes_malloc(matcher->nodes_count * sizeof(int));
+        status = states ? jfes_success : jfes_no_memory;
     }
 
-    jfes_reset_parser(parser);
+    if (jfes_status_is_good(status)) {
+        jfes_tokens_data_t tokens_data = { 0 };
+        tokens_data.config = config;
+
+        tokens_data.json_data = json;
+        tokens_data.json_data_length = length;
+
+        tokens_data.tokens = tokens;
+        tokens_data.tokens_count = tokens_count;
+        tokens_data.current_token = 0;
 
-    jfes_token_t *token = JFES_NULL;
+        states[0] = 0;
+        status = jfes_create_projected_node(&tokens_data, JFES_NULL, matcher, states, 0, 1, value);
+    }
 
-    jfes_size_t count = parser->next_token;
-    while (parser->pos < length && json[parser->pos] != '\0') {
-        char c = json[parser->pos];
-        switch (c) {
-        case '{': case '[':
-            {
-                count++;
-                token = jfes_allocate_token(parser, tokens, *max_tokens_count);
-                if (!token) {
-                    return jfes_no_memory;
-                }
-                if (parser->superior_token != -1) {
-                    tokens[parser->superior_token].size++;
-                }
+    if (states) {
+        config->jfes_free(states);
+    }
+    if (tokens) {
+        config->jfes_free(tokens);
+    }
+    return status;
+}
 
-                token->type = (c == '{' ? jfes_type_object : jfes_type_array);
-                token->start = parser->pos;
-                parser->superior_token = parser->next_token - 1;
-            }
-            break;
+#ifdef JFES_USE_THREADS
+/** Count of records parsed by the worker pool at once. */
+#define JFES_LINES_BATCH_SIZE           1024
+
+/** Record of JSON Lines. */
+typedef struct jfes_line_record {
+    jfes_size_t             start;              /**< Record start. */
+    jfes_size_t             length;             /**< Record length. */
+    jfes_status_t           status;             /**< Parsing status. */
+    jfes_value_t            value;              /**< Parsed value. */
+} jfes_line_record_t;
+
+/** Worker pool shared state. */
+typedef struct jfes_lines_pool {
+    const jfes_config_t     *config;            /**< JFES configuration. */
+    const char              *json;              /**< JSON Lines data. */
+
+    jfes_line_record_t      *records;           /**< Records of the current batch. */
+    jfes_size_t             records_count;      /**< Records count in the current batch. */
+    jfes_size_t             workers_count;      /**< Workers count, including the calling thread. */
+
+    pthread_mutex_t         mutex;              /**< Protects the fields below. */
+    pthread_cond_t          start_condition;    /**< Signaled when the new batch is ready. */
+    pthread_cond_t          done_condition;     /**< Signaled when the last worker finishes the batch. */
+    unsigned long           generation;         /**< Current batch number. */
+    jfes_size_t             pending;            /**< Count of the workers which are still busy. */
+    int                     stop;               /**< Non-zero if the workers must exit. */
+} jfes_lines_pool_t;
+
+/** Worker of the pool. */
+typedef struct jfes_lines_worker {
+    jfes_lines_pool_t       *pool;              /**< Worker pool. */
+    jfes_size_t             index;              /**< Worker index. Zero for the calling thread. */
+    jfes_parser_t           parser;             /**< Worker parser. */
+    jfes_token_t            *tokens;            /**< Tokens array reused for every record. */
+    jfes_size_t             capacity;           /**< Tokens array capacity. */
+    pthread_t               thread;             /**< Worker thread. */
+} jfes_lines_worker_t;
 
-        case '}': case ']':
-            {
-                int i = 0;
-                for (i = (int)parser->next_token - 1; i >= 0; i--) {
-                    token = &tokens[i];
-                    if (token->start != -1 && token->end == -1) {
-                        parser->superior_token = -1;
-                        token->end = parser->pos + 1;
-                        break;
-                    }
-                }
+/**
+    Finds the end of the line. Checks 32 (AVX2) or 16 (SSE2) bytes at once.
 
-                if (i == -1) {
-                    return jfes_invalid_input;
-                }
+    \param[in]      json                JSON Lines data.
+    \param[in]      pos                 Position to start from.
+    \param[in]      length              Data length.
 
-                while (i >= 0) {
-                    token = &tokens[i];
-                    if (token->start != -1 && token->end == -1) {
-                        parser->superior_token = i;
-                        break;
-                    }
-                    i--;
-                }
-            }
-            break;
+    \return         Position of the newline or `length` if this is the last line.
+*/
+static jfes_size_t jfes_find_line_end(const char *json, jfes_size_t pos, jfes_size_t length) {
+#if defined(JFES_AVX2)
+    const __m256i newline = _mm256_set1_epi8('\n');
+    while (pos + 32 <= length) {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(json + pos));
+        const unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newline));
+        if (mask) {
+            return pos + jfes_count_trailing_zeros(mask);
+        }
+        pos += 32;
+    }
+#elif defined(JFES_SSE2)
+    const __m128i newline = _mm_set1_epi8('\n');
+    while (pos + 16 <= length) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(json + pos));
+        const unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(v, newline));
+        if (mask) {
+            return pos + jfes_count_trailing_zeros(mask);
+        }
+        pos += 16;
+    }
+#endif
 
-        case '\"':
-            {
-                jfes_status_t status = jfes_parse_string(parser, json, length, tokens, *max_tokens_count);
-                if (jfes_status_is_bad(status)) {
-                    return status;
-                }
+    while (pos < length && json[pos] != '\n') {
+        pos++;
+    }
 
-                count++;
+    return pos;
+}
 
-                if (parser->superior_token != -1 && tokens != JFES_NULL) {
-                    tokens[parser->superior_token].size++;
-                }
-            }
-            break;
+/**
+    Parses the worker share of the current batch: every `workers_count`-th record.
 
-        case '\t': case '\r': case '\n': case ' ':
-            break;
+    \param[in, out] worker              Pointer to the jfes_lines_worker_t object.
+*/
+static void jfes_parse_lines_share(jfes_lines_worker_t *worker) {
+    jfes_lines_pool_t *pool = worker->pool;
 
-        case ':':
-            parser->superior_token = parser->next_token - 1;
-            break;
+    for (jfes_size_t i = worker->index; i < pool->records_count; i += pool->workers_count) {
+        jfes_line_record_t *record = &pool->records[i];
+        record->status = jfes_parse_to_value_reusing(&worker->parser, pool->json + record->start,
+            record->length, &worker->tokens, &worker->capacity, JFES_NULL, &record->value);
+    }
+}
 
-        case ',':
-            {
-                if (parser->superior_token != -1 &&
-                    tokens[parser->superior_token].type != jfes_type_array &&
-                    tokens[parser->superior_token].type != jfes_type_object) {
-                    for (int i = parser->next_token - 1; i >= 0; i--) {
-                        if (tokens[i].type == jfes_type_array || tokens[i].type == jfes_type_object) {
-                            if (tokens[i].start != -1 && tokens[i].end == -1) {
-                                parser->superior_token = i;
-                                break;
-                            }
-                        }
-                    }
-                }
-            }
-            break;
+/**
+    Worker thread: parses its share of every batch until the pool stops.
 
-#ifdef JFES_STRICT
-        case '-': case '0': case '1': case '2': case '3': case '4':
-        case '5': case '6': case '7': case '8': case '9':
-        case 't': case 'f': case 'n':
-            if (parser->superior_token != -1) {
-                jfes_token_t *token = &tokens[parser->superior_token];
-                if (token->type == jfes_object || (token->type == jfes_string && token->size != 0)) {
-                    return jfes_invalid_input;
-                }
-            }
-#else
-        default:
-#endif
-            {
-                jfes_status_t status = jfes_parse_primitive(parser, json, length, tokens, *max_tokens_count);
-                if (jfes_status_is_bad(status)) {
-                    return status;
-                }
+    \param[in, out] argument            Pointer to the jfes_lines_worker_t object.
 
-                count++;
-                if (parser->superior_token != -1) {
-                    tokens[parser->superior_token].size++;
-                }
-            }
+    \return         JFES_NULL.
+*/
+static void *jfes_lines_worker(void *argument) {
+    jfes_lines_worker_t *worker = (jfes_lines_worker_t*)argument;
+    jfes_lines_pool_t *pool = worker->pool;
+
+    unsigned long generation = 0;
+    for (;;) {
+        pthread_mutex_lock(&pool->mutex);
+        while (pool->generation == generation && !pool->stop) {
+            pthread_cond_wait(&pool->start_condition, &pool->mutex);
+        }
+        if (pool->stop) {
+            pthread_mutex_unlock(&pool->mutex);
             break;
-#ifdef JFES_STRICT
-        default:
-            return jfes_invalid_input;
-#endif
         }
-        parser->pos++;
-    }
+        generation = pool->generation;
+        pthread_mutex_unlock(&pool->mutex);
 
-    for (int i = (int)parser->next_token - 1; i >= 0; i--) {
-        if (tokens[i].start != -1 && tokens[i].end == -1) {
-            return jfes_error_part;
+        jfes_parse_lines_share(worker);
+
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->pending == 0) {
+            pthread_cond_signal(&pool->done_condition);
         }
+        pthread_mutex_unlock(&pool->mutex);
     }
 
-    *max_tokens_count = count;
-    return jfes_success;
+    return JFES_NULL;
 }
 
 /**
-    Creates jfes value node from the tokens sequence.
+    Parses the current batch on all workers and waits for them.
 
-    \param[in]      tokens_data         Pointer to the jfes_tokens_data_t object.
-    \param[out]     value               Pointer to the value to create node.
-
-    \return         jfes_success if everything is OK.
+    \param[in, out] workers             Workers array. The first one is the calling thread.
 */
-static jfes_status_t jfes_create_node(jfes_tokens_data_t *tokens_data, jfes_value_t *value) {
-    if (!tokens_data || !value) {
-        return jfes_invalid_arguments;
-    }
+static void jfes_parse_lines_batch(jfes_lines_worker_t *workers) {
+    jfes_lines_pool_t *pool = workers[0].pool;
 
-    if (tokens_data->current_token >= tokens_data->tokens_count) {
-        return jfes_invalid_arguments;
-    }
+    pthread_mutex_lock(&pool->mutex);
+    pool->pending = pool->workers_count - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start_condition);
+    pthread_mutex_unlock(&pool->mutex);
 
-    jfes_malloc_t jfes_malloc = tokens_data->config->jfes_malloc;
-    jfes_free_t   jfes_free   = tokens_data->config->jfes_free;
+    jfes_parse_lines_share(&workers[0]);
 
-    jfes_token_t *token = &tokens_data->tokens[tokens_data->current_token];
-    tokens_data->current_token++;
-    
-    value->type = token->type;
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->done_condition, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+}
 
-    switch (token->type) {
-    case jfes_type_null:
-        break;
+/**
+    Returns the monotonic wall clock time in seconds.
 
-    case jfes_type_boolean:
-        value->data.bool_val = jfes_string_to_boolean(tokens_data->json_data + token->start, 
-            token->end - token->start);
-        break;
+    \return         Wall clock time in seconds.
+*/
+static double jfes_wall_time(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
 
-    case jfes_type_integer:
-        value->data.int_val = jfes_string_to_integer(tokens_data->json_data + token->start,
-            token->end - token->start);
-        break;
+jfes_status_t jfes_parse_lines(const jfes_config_t *config, const char *json, jfes_size_t length,
+        jfes_size_t threads_count, jfes_record_callback_t callback, void *context, jfes_lines_stats_t *stats) {
+    if (!jfes_check_configuration(config) || !json || !callback) {
+        return jfes_invalid_arguments;
+    }
 
-    case jfes_type_double:
-        value->data.double_val = jfes_string_to_double(tokens_data->json_data + token->start,
-            token->end - token->start);
-        break;
+    if (threads_count == 0) {
+        threads_count = 1;
+    }
+    if (threads_count > JFES_MAX_THREADS) {
+        threads_count = JFES_MAX_THREADS;
+    }
 
-    case jfes_type_string:
-        jfes_create_string(tokens_data->config, &value->data.string_val, 
-            tokens_data->json_data + token->start, token->end - token->start);
-        break;
+    const double start_time = jfes_wall_time();
 
-    case jfes_type_array:
-        value->data.array_val = (jfes_array_t*)jfes_malloc(sizeof(jfes_array_t));
-        if (!value->data.array_val) {
-            return jfes_no_memory;
-        }
+    jfes_lines_pool_t pool;
+    pool.config = config;
+    pool.json = json;
+    pool.records_count = 0;
+    pool.workers_count = threads_count;
+    pool.generation = 0;
+    pool.pending = 0;
+    pool.stop = 0;
 
-        if (token->size > 0) {
-            value->data.array_val->count = token->size;
-            value->data.array_val->items = (jfes_value_t**)jfes_malloc(token->size * sizeof(jfes_value_t*));
-            if (!value->data.array_val->items) {
-                jfes_free(value->data.array_val);
-                return jfes_no_memory;
-            }
+    pool.records = (jfes_line_record_t*)config->jfes_malloc(JFES_LINES_BATCH_SIZE * sizeof(jfes_line_record_t));
+    if (!pool.records) {
+        return jfes_no_memory;
+    }
 
-            for (jfes_size_t i = 0; i < token->size; i++) {
-                jfes_value_t *item = (jfes_value_t*)jfes_malloc(sizeof(jfes_value_t));
-                if (!item) {
-                    jfes_free(value->data.array_val->items);
-                    jfes_free(value->data.array_val);
-                    return jfes_no_memory;
-                }
-                value->data.array_val->items[i] = item;
+    pthread_mutex_init(&pool.mutex, JFES_NULL);
+    pthread_cond_init(&pool.start_condition, JFES_NULL);
+    pthread_cond_init(&pool.done_condition, JFES_NULL);
 
-                jfes_status_t status = jfes_create_node(tokens_data, item);
-                if (jfes_status_is_bad(status)) {
-                    value->data.array_val->count = i + 1;
+    jfes_lines_worker_t workers[JFES_MAX_THREADS];
+    jfes_size_t started = 1;
+    for (jfes_size_t i = 0; i < threads_count; i++) {
+        workers[i].pool = &pool;
+        workers[i].index = i;
+        workers[i].tokens = JFES_NULL;
+        workers[i].capacity = 0;
+        jfes_init_parser(&workers[i].parser, config);
 
-                    jfes_free_value(tokens_data->config, value);
-                    return status;
-                }
+        if (i > 0) {
+            if (pthread_create(&workers[i].thread, JFES_NULL, jfes_lines_worker, &workers[i]) != 0) {
+                break;
             }
+            started++;
         }
-        break;
+    }
 
-    case jfes_type_object:
-        value->data.object_val = (jfes_object_t*)jfes_malloc(sizeof(jfes_object_t));
-        if (!value->data.object_val) {
-            return jfes_no_memory;
-        }
+    /* The calling thread takes the share of the workers which were not started. */
+    pool.workers_count = started;
 
-        if (token->size > 0) {
-            value->data.object_val->count = token->size;
-            value->data.object_val->items = (jfes_object_map_t**)jfes_malloc(token->size * sizeof(jfes_object_map_t*));
-            if (!value->data.object_val->items) {
-                jfes_free(value->data.object_val);
-                return jfes_no_memory;
+    jfes_size_t records_count = 0;
+    jfes_size_t errors_count = 0;
+
+    jfes_size_t pos = 0;
+    int stopped = 0;
+    while (pos < length && !stopped) {
+        /* Splits the next batch. Lines without anything but whitespaces are skipped. */
+        pool.records_count = 0;
+        while (pos < length && pool.records_count < JFES_LINES_BATCH_SIZE) {
+            const jfes_size_t end = jfes_find_line_end(json, pos, length);
+
+            jfes_size_t first = pos;
+            while (first < end && (json[first] == ' ' || json[first] == '\t' || json[first] == '\r')) {
+                first++;
             }
 
-            for (jfes_size_t i = 0; i < token->size; i++) {
-                jfes_object_map_t *item = (jfes_object_map_t*)jfes_malloc(sizeof(jfes_object_map_t));
-                if (!item) {
-                    jfes_free(value->data.object_val->items);
-                    jfes_free(value->data.object_val);
-                    return jfes_no_memory;
-                }
-                value->data.object_val->items[i] = item;
+            if (first < end) {
+                jfes_line_record_t *record = &pool.records[pool.records_count++];
+                record->start = first;
+                record->length = end - first;
+            }
 
-                jfes_token_t *key_token = &tokens_data->tokens[tokens_data->current_token++];
-                
-                jfes_size_t key_length = key_token->end - key_token->start;
+            pos = end + 1;
+        }
 
-                jfes_create_string(tokens_data->config, &item->key, 
-                    tokens_data->json_data + key_token->start, key_length);
+        jfes_parse_lines_batch(workers);
 
-                item->value = (jfes_value_t*)jfes_malloc(sizeof(jfes_value_t));
+        /* Results are delivered in the records order. */
+        for (jfes_size_t i = 0; i < pool.records_count; i++) {
+            jfes_line_record_t *record = &pool.records[i];
+            const int parsed = jfes_status_is_good(record->status);
 
-                jfes_status_t status = jfes_create_node(tokens_data, item->value);
-                if (jfes_status_is_bad(status)) {
-                    value->data.object_val->count = i + 1;
+            if (!stopped) {
+                errors_count += !parsed;
+                stopped = !callback(context, records_count++, record->status, parsed ? &record->value : JFES_NULL);
+            }
 
-                    jfes_free_value(tokens_data->config, value);
-                    return status;
-                }
+            if (parsed) {
+                jfes_free_value(config, &record->value);
             }
         }
-        break;
+    }
 
-    default:
-        return jfes_unknown_type;
+    pthread_mutex_lock(&pool.mutex);
+    pool.stop = 1;
+    pthread_cond_broadcast(&pool.start_condition);
+    pthread_mutex_unlock(&pool.mutex);
+
+    for (jfes_size_t i = 0; i < started; i++) {
+        if (i > 0) {
+            pthread_join(workers[i].thread, JFES_NULL);
+        }
+        if (workers[i].tokens) {
+            config->jfes_free(workers[i].tokens);
+        }
+    }
+
+    pthread_cond_destroy(&pool.done_condition);
+    pthread_cond_destroy(&pool.start_condition);
+    pthread_mutex_destroy(&pool.mutex);
+    config->jfes_free(pool.records);
+
+    if (stats) {
+        stats->records_count = records_count;
+        stats->errors_count = errors_count;
+        stats->seconds = jfes_wall_time() - start_time;
+        stats->records_per_second = stats->seconds > 0.0 ? records_count / stats->seconds : 0.0;
     }
+
     return jfes_success;
 }
+#endif
 
-jfes_status_t jfes_parse_to_value(const jfes_config_t *config, const char *json,
-        jfes_size_t length, jfes_value_t *value) {
-    if (!jfes_check_configuration(config) || !json || length == 0 || !value) {
+#ifdef JFES_USE_MMAP
+jfes_status_t jfes_map_file(const char *filename, jfes_mapped_file_t *file) {
+    if (!filename || !file) {
         return jfes_invalid_arguments;
     }
 
-    jfes_parser_t parser;
-    jfes_status_t status = jfes_init_parser(&parser, config);
-    if (jfes_status_is_bad(status)) {
-        return status;
+    file->data = JFES_NULL;
+    file->length = 0;
+
+    const int descriptor = open(filename, O_RDONLY);
+    if (descriptor < 0) {
+        return jfes_not_found;
     }
 
-    jfes_size_t tokens_count = 1024;
-    jfes_token_t *tokens = JFES_NULL;
+    struct stat file_stat;
+    if (fstat(descriptor, &file_stat) != 0 || file_stat.st_size < 0
+        || (unsigned long long)file_stat.st_size > (jfes_size_t)-1) {
+        close(descriptor);
+        return jfes_no_memory;
+    }
 
-    status = jfes_no_memory;
-    while (status == jfes_no_memory && tokens_count <= JFES_MAX_TOKENS_COUNT) {
-        jfes_reset_parser(&parser);
+    if (file_stat.st_size == 0) {
+        close(descriptor);
+        file->data = "";
+        return jfes_success;
+    }
 
-        tokens = (jfes_token_t*)parser.config->jfes_malloc(tokens_count * sizeof(jfes_token_t));
-        if (!tokens) {
-            return jfes_no_memory;
-        }
+    void *address = mmap(JFES_NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (address == MAP_FAILED) {
+        return jfes_no_memory;
+    }
 
-        jfes_size_t current_tokens_count = tokens_count;
-        status = jfes_parse_tokens(&parser, json, length, tokens, &current_tokens_count);
-        if (jfes_status_is_good(status)) {
-            tokens_count = current_tokens_count;
-            break;
-        }
+    /* JSON is read from the start to the end: let the system read ahead. */
+    posix_madvise(address, (size_t)file_stat.st_size, POSIX_MADV_SEQUENTIAL);
 
-        tokens_count *= 2;
-        parser.config->jfes_free(tokens);
+    file->data = (const char*)address;
+    file->length = (jfes_size_t)file_stat.st_size;
+    return jfes_success;
+}
+
+jfes_status_t jfes_unmap_file(jfes_mapped_file_t *file) {
+    if (!file) {
+        return jfes_invalid_arguments;
     }
-    
-    if (jfes_status_is_bad(status)) {
-        return status;
+
+    if (file->length > 0 && munmap((void*)file->data, file->length) != 0) {
+        return jfes_invalid_arguments;
     }
 
-    jfes_tokens_data_t tokens_data = { 0 };
-    tokens_data.config = config;
+    file->data = JFES_NULL;
+    file->length = 0;
+    return jfes_success;
+}
 
-    tokens_data.json_data = json;
-    tokens_data.json_data_length = length;
+jfes_status_t jfes_parse_file_to_value(const jfes_config_t *config, const char *filename, jfes_value_t *value) {
+    if (!jfes_check_configuration(config) || !filename || !value) {
+        return jfes_invalid_arguments;
+    }
 
-    tokens_data.tokens = tokens;
-    tokens_data.tokens_count = tokens_count;
-    tokens_data.current_token = 0;
+    jfes_mapped_file_t file;
+    jfes_status_t status = jfes_map_file(filename, &file);
+    if (jfes_status_is_bad(status)) {
+        return status;
+    }
 
-    status = jfes_create_node(&tokens_data, value); /* what if no success here? */
+    status = jfes_parse_to_value(config, file.data, file.length, value);
 
-    parser.config->jfes_free(tokens);
-    return jfes_success;
+    jfes_unmap_file(&file);
+    return status;
 }
+#endif
 
 jfes_status_t jfes_free_value(const jfes_config_t *config, jfes_value_t *value) {
     if (!jfes_check_configuration(config) || !value) {
@@ -1288,7 +6961,7 @@ jfes_status_t jfes_free_value(const jfes_config_t *config, jfes_value_t *value)
             for (jfes_size_t i = 0; i < value->data.object_val->count; i++) {
                 jfes_object_map_t *object_map = value->data.object_val->items[i];
 
-                config->jfes_free(object_map->key.data);
+                jfes_free_string(config, &object_map->key);
 
                 jfes_free_value(config, object_map->value);
                 config->jfes_free(object_map->value);
@@ -1302,9 +6975,7 @@ jfes_status_t jfes_free_value(const jfes_config_t *config, jfes_value_t *value)
         config->jfes_free(value->data.object_val);
     }
     else if (value->type == jfes_type_string) {
-        if (value->data.string_val.size > 0) {
-            config->jfes_free(value->data.string_val.data);
-        }
+        jfes_free_string(config, &value->data.string_val);
     }
 
     return jfes_success;
@@ -1339,7 +7010,7 @@ jfes_value_t *jfes_create_boolean_value(const jfes_config_t *config, int value)
     return result;
 }
 
-jfes_value_t *jfes_create_integer_value(const jfes_config_t *config, int value) {
+jfes_value_t *jfes_create_integer_value(const jfes_config_t *config, jfes_integer_t value) {
     if (!config) {
         return JFES_NULL;
     }
@@ -1742,7 +7413,7 @@ static jfes_status_t jfes_object_value_to_stream_helper(const jfes_value_t *valu
         }
 
         jfes_add_to_stringstream(stream, "\"", 0);
-        jfes_add_to_stringstream(stream, object_map->key.data, object_map->key.size - 1);
+        jfes_add_escaped_to_stringstream(stream, object_map->key.data, object_map->key.size - 1);
         jfes_add_to_stringstream(stream, "\":", 0);
         if (beautiful) {
             jfes_add_to_stringstream(stream, " ", 0);
@@ -1783,21 +7454,17 @@ static jfes_status_t jfes_value_to_stream_helper(const jfes_value_t *value, jfes
         return jfes_add_to_stringstream(stream, jfes_boolean_to_string(value->data.bool_val), 0);
 
     case jfes_type_integer:
-    {
-        char buffer[JFES_MAX_DIGITS];
-        return jfes_add_to_stringstream(stream, jfes_integer_to_string_r(value->data.int_val, &buffer[0], JFES_MAX_DIGITS), 0);
-    }
+        return jfes_add_integer_to_stringstream(stream, value->data.int_val);
 
     case jfes_type_double:
     {
         char buffer[JFES_MAX_DIGITS];
-        return jfes_add_to_stringstream(stream, jfes_double_to_string_r(
-            value->data.double_val, &buffer[0], JFES_MAX_DIGITS, JFES_DOUBLE_PRECISION), 0);
+        return jfes_add_to_stringstream(stream, jfes_double_to_string_r(value->data.double_val, &buffer[0], JFES_MAX_DIGITS), 0);
     }
 
     case jfes_type_string:
         jfes_add_to_stringstream(stream, "\"", 0);
-        jfes_add_to_stringstream(stream, value->data.string_val.data, value->data.string_val.size - 1);
+        jfes_add_escaped_to_stringstream(stream, value->data.string_val.data, value->data.string_val.size - 1);
         return jfes_add_to_stringstream(stream, "\"", 0);
 
     case jfes_type_array:
@@ -11,8 +11,23 @@
 /** Strict JSON mode. **/
 //#define JFES_STRICT
 
-/** Maximal tokens count */
-#define JFES_MAX_TOKENS_COUNT   8192
+/** Use SSE2/AVX2 instructions (when available) to classify input characters. **/
+//#define JFES_USE_SIMD
+
+/** Store decoded values of numbers and booleans in tokens, so they are parsed only once. **/
+//#define JFES_TOKEN_VALUES
+
+/** Check that strings are valid UTF-8. **/
+//#define JFES_VALIDATE_UTF8
+
+/** Parse integers as decimal only, without octal and hexadecimal literals. Always on in strict mode. **/
+//#define JFES_DECIMAL_ONLY
+
+/** Enable jfes_parse_tokens_parallel and jfes_parse_lines. Needs POSIX threads and a thread-safe allocator. **/
+//#define JFES_USE_THREADS
+
+/** Enable loading of the memory-mapped files. Needs POSIX mmap. **/
+//#define JFES_USE_MMAP
 
 /** NULL define for the jfes library. */
 #ifndef JFES_NULL
@@ -22,6 +37,9 @@
 /** size_t type for the jfes library. */
 typedef unsigned int jfes_size_t;
 
+/** Integer type for the jfes library. */
+typedef long long jfes_integer_t;
+
 /** JFES return statuses. */
 typedef enum jfes_status {
     jfes_unknown            = 0x00,             /**< Unknown status */
@@ -34,6 +52,8 @@ typedef enum jfes_status {
     jfes_error_part         = 0x05,             /**< The string is not a full JSON packet. More bytes expected. */
     jfes_unknown_type       = 0x06,             /**< Unknown token type. */
     jfes_not_found          = 0x07,             /**< Something was not found. */
+    jfes_wrong_type         = 0x08,             /**< Value has another type. */
+    jfes_stopped            = 0x09,             /**< Parsing was stopped by the callback. */
 } jfes_status_t;
 
 /** Memory allocator function type. */
@@ -45,7 +65,9 @@ typedef void (*jfes_free_t)(void*);
 /** JFES string type. */
 typedef struct jfes_string {
     char            *data;                      /**< String bytes. */
-    jfes_size_t     size;                       /**< Allocated bytes count. */
+    jfes_size_t     size;                       /**< String length with the terminating zero. */
+    int             borrowed;                   /**< Non-zero if the data points into the parsed JSON
+                                                     (see jfes_parse_to_value_in_situ) and is not freed. */
 } jfes_string_t;
 
 /** JFES token types */
@@ -66,6 +88,13 @@ typedef enum jfes_token_type {
 /** Json value type is the same as token type. */
 typedef jfes_token_type_t jfes_value_type_t;
 
+/** JFES decoded value of the boolean or number token. */
+typedef union jfes_token_value {
+    int                     bool_val;           /**< Boolean value. */
+    jfes_integer_t          int_val;            /**< Integer value. */
+    double                  double_val;         /**< Double value. */
+} jfes_token_value_t;
+
 /** JFES token structure. */
 typedef struct jfes_token {
     jfes_token_type_t       type;               /**< Token type. */
@@ -73,8 +102,25 @@ typedef struct jfes_token {
     int                     start;              /**< Token start position. */
     int                     end;                /**< Token end position. */
     jfes_size_t             size;               /**< Token children count. */
+    int                     parent;             /**< Parent token index or -1 for the root token. */
+
+#ifdef JFES_TOKEN_VALUES
+    jfes_token_value_t      value;              /**< Decoded value of the boolean or number token. */
+#endif
 } jfes_token_t;
 
+/** Number of bits for the token type in jfes_compact_token_t. */
+#define JFES_COMPACT_TYPE_BITS  3
+
+/** Maximal token start position in jfes_compact_token_t. */
+#define JFES_COMPACT_MAX_START  ((1u << (32 - JFES_COMPACT_TYPE_BITS)) - 1)
+
+/** JFES compact token structure. Takes 8 bytes. */
+typedef struct jfes_compact_token {
+    unsigned int            info;               /**< Token type (lower bits) and start position (upper bits). */
+    unsigned int            next;               /**< Index of the first token after this token's subtree. */
+} jfes_compact_token_t;
+
 /** JFES config structure. */
 typedef struct jfes_config {
     jfes_malloc_t           jfes_malloc;        /**< Memory allocation function. */
@@ -98,10 +144,161 @@ typedef struct jfes_parser {
     jfes_size_t             pos;                /**< Current offset in json string. */ 
     jfes_size_t             next_token;         /**< Next token to allocate. */
     int                     superior_token;     /**< Superior token node. */
+    jfes_size_t             part_end;           /**< Scanned part of the unfinished string or primitive at `pos`. */
+
+#ifdef JFES_USE_SIMD
+    jfes_size_t             block_start;        /**< Offset of the classified 64-byte block. */
+    unsigned long long      whitespace_mask;    /**< Whitespace characters in the classified block. */
+    unsigned long long      delimiter_mask;     /**< Characters that finish a primitive in the classified block. */
+#endif
 
     const jfes_config_t     *config;            /**< Pointer to jfes config. */
 } jfes_parser_t;
 
+/** JFES SAX parser events. */
+typedef enum jfes_sax_event {
+    jfes_sax_start_object       = 0x00,         /**< Object begins. */
+    jfes_sax_end_object         = 0x01,         /**< Object ends. */
+    jfes_sax_start_array        = 0x02,         /**< Array begins. */
+    jfes_sax_end_array          = 0x03,         /**< Array ends. */
+    jfes_sax_key                = 0x04,         /**< Object key. */
+    jfes_sax_value              = 0x05,         /**< String or primitive value. */
+} jfes_sax_event_t;
+
+/** JFES SAX parser value: object key, string or primitive. */
+typedef struct jfes_sax_value {
+    jfes_token_type_t       type;               /**< Value type. Keys are strings. */
+    const char              *data;              /**< Value data. Strings are without quotes, escape sequences are not decoded. */
+    jfes_size_t             length;             /**< Value data length. */
+    jfes_token_value_t      value;              /**< Decoded value of the boolean or number. */
+} jfes_sax_value_t;
+
+/**
+    SAX parser callback.
+
+    \param[in]      context             User data.
+    \param[in]      event               Parser event.
+    \param[in]      value               Key or value for the jfes_sax_key and jfes_sax_value events,
+                                        JFES_NULL otherwise. Valid only until the callback returns.
+
+    \return         Zero to stop parsing. Anything otherwise.
+*/
+typedef int (*jfes_sax_callback_t)(void *context, jfes_sax_event_t event, const jfes_sax_value_t *value);
+
+/** JFES SAX parser structure. Memory use depends only on nesting depth and the longest value. */
+typedef struct jfes_sax_parser {
+    jfes_sax_callback_t     callback;           /**< Events callback. */
+    void                    *context;           /**< User data for the callback. */
+
+    unsigned char           *levels;            /**< Bit per nesting level: 1 for objects, 0 for arrays. */
+    jfes_size_t             max_depth;          /**< Maximal nesting depth. */
+    jfes_size_t             depth;              /**< Current nesting depth. */
+
+    char                    *buffer;            /**< Buffer for the values which are split between chunks. */
+    jfes_size_t             buffer_size;        /**< Buffer size. */
+    jfes_size_t             buffer_length;      /**< Length of the unfinished value in the buffer. */
+
+    unsigned int            state;              /**< Out of values, inside a string or inside a primitive. */
+    unsigned int            escape;             /**< State of the unfinished escape sequence. */
+    int                     expect_key;         /**< Non-zero if the next string is an object key. */
+} jfes_sax_parser_t;
+
+/**
+    Reader callback: fills the buffer with the next bytes of data.
+
+    \param[in]      context             User data.
+    \param[out]     buffer              Buffer for the data.
+    \param[in]      size                Buffer size.
+
+    \return         Count of the bytes read. Zero at the end of data.
+*/
+typedef jfes_size_t (*jfes_reader_t)(void *context, char *buffer, jfes_size_t size);
+
+#ifdef JFES_USE_MMAP
+/** JFES memory-mapped file. */
+typedef struct jfes_mapped_file {
+    const char              *data;              /**< File data. Read-only. */
+    jfes_size_t             length;             /**< File data length. */
+} jfes_mapped_file_t;
+#endif
+
+/** JFES pull cursor structure. Reads events one by one from the raw data or from the tokens. */
+typedef struct jfes_cursor {
+    const char              *json;              /**< JSON data string. */
+    jfes_size_t             length;             /**< JSON data length. */
+
+    const jfes_token_t      *tokens;            /**< Tokens of the data or JFES_NULL to read the raw data. */
+    jfes_size_t             tokens_count;       /**< Tokens count. */
+    int                     container;          /**< Index of the innermost open container token or -1. */
+
+    jfes_size_t             pos;                /**< Next position in the raw data or index of the next token. */
+    unsigned char           *levels;            /**< Raw data only. Bit per nesting level: 1 for objects, 0 for arrays. */
+    jfes_size_t             max_depth;          /**< Raw data only. Maximal nesting depth. */
+    jfes_size_t             depth;              /**< Current nesting depth. */
+    int                     expect_key;         /**< Raw data only. Non-zero if the next string is an object key. */
+
+    jfes_reader_t           reader;             /**< Reader of the data or JFES_NULL if all the data is in memory. */
+    void                    *reader_context;    /**< User data for the reader. */
+    char                    *window;            /**< Reader only. Window for the data, `json` points to it. */
+    jfes_size_t             window_size;        /**< Reader only. Window size. */
+
+    jfes_sax_event_t        event;              /**< Current event. */
+    jfes_sax_value_t        value;              /**< Current key or value for the jfes_sax_key and jfes_sax_value events. */
+} jfes_cursor_t;
+
+/** JFES path matcher node: one reference token of the compiled JSON Pointers. */
+typedef struct jfes_path_node {
+    const char              *reference;         /**< Reference token, not copied. `*` matches any key or index. */
+    jfes_size_t             reference_length;   /**< Reference token length. */
+    int                     index;              /**< Array index of the reference or -1. */
+
+    int                     first_child;        /**< Index of the first child node or -1. */
+    int                     next;               /**< Index of the next sibling node or -1. */
+    int                     path;               /**< Index of the path which ends at this node or -1. */
+} jfes_path_node_t;
+
+/** JFES path matcher: a trie of JSON Pointers matched in one pass over the cursor. */
+typedef struct jfes_matcher {
+    jfes_path_node_t        *nodes;             /**< Trie nodes. The first one is the root. */
+    jfes_size_t             nodes_count;        /**< Trie nodes count. */
+    jfes_size_t             max_nodes_count;    /**< Nodes array size. */
+    jfes_size_t             paths_count;        /**< Count of the added paths. */
+} jfes_matcher_t;
+
+/** JFES struct field types. */
+typedef enum jfes_field_type {
+    jfes_field_boolean          = 0x00,         /**< int. */
+    jfes_field_integer          = 0x01,         /**< jfes_integer_t. */
+    jfes_field_double           = 0x02,         /**< double. Integers are converted. */
+    jfes_field_string           = 0x03,         /**< Array of `size` chars. Zero-terminated, escapes are decoded.
+                                                     The decoded string with its zero must fit. */
+    jfes_field_object           = 0x04,         /**< Nested struct of `size` bytes described by `fields`. */
+} jfes_field_type_t;
+
+/** JFES struct field descriptor. Fields tables end with the JFES_NULL name. */
+typedef struct jfes_field jfes_field_t;
+struct jfes_field {
+    const char              *name;              /**< Object key as it is written in JSON. */
+    jfes_size_t             offset;             /**< Field offset in the struct. */
+    jfes_field_type_t       type;               /**< Field type or array item type. */
+    const jfes_field_t      *fields;            /**< Fields of the nested struct for jfes_field_object. */
+    jfes_size_t             size;               /**< Size of the string buffer or of the nested struct. */
+    jfes_size_t             capacity;           /**< Array items capacity. Zero if the field is not an array. */
+    jfes_size_t             count_offset;       /**< Arrays only. Offset of the jfes_size_t items count in the struct. */
+};
+
+/**
+    Path matcher callback.
+
+    \param[in]      context             User data.
+    \param[in]      path                Index of the matched path.
+    \param[in]      cursor              Cursor at the first event of the matched value. For the
+                                        tokens cursor the index of the value token is `cursor->pos` - 1.
+
+    \return         Zero to stop matching. Anything otherwise.
+*/
+typedef int (*jfes_match_callback_t)(void *context, jfes_size_t path, const jfes_cursor_t *cursor);
+
 
 /** JSON value structure. */
 typedef struct jfes_value jfes_value_t;
@@ -128,7 +325,7 @@ typedef struct jfes_object {
 typedef union jfes_value_data {
     int                     bool_val;           /**< Boolean JSON value. */
 
-    int                     int_val;            /**< Integer JSON value. */
+    jfes_integer_t          int_val;            /**< Integer JSON value. */
     double                  double_val;         /**< Double JSON value. */
     jfes_string_t           string_val;         /**< String JSON value. */
 
@@ -195,6 +392,396 @@ jfes_status_t jfes_reset_parser(jfes_parser_t *parser);
 jfes_status_t jfes_parse_tokens(jfes_parser_t *parser, const char *json, 
     jfes_size_t length, jfes_token_t *tokens, jfes_size_t *max_tokens_count);
 
+/**
+    Continues JSON parsing from the current parser state. Use it when the data
+    arrives in parts: every call scans only the bytes that were not scanned yet.
+    Start with a fresh (or reset) parser and pass the whole data received so far
+    with the same tokens after each jfes_error_part or jfes_no_memory result.
+
+    \param[in, out] parser              Pointer to the jfes_parser_t object.
+    \param[in]      json                JSON data string received so far.
+    \param[in]      length              JSON data length.
+    \param[out]     tokens              Tokens array to fill. Can be reallocated between calls,
+                                        but must keep already parsed tokens.
+    \param[in, out] max_tokens_count    Maximal count of tokens in tokens array.
+                                        Will contain tokens count.
+
+    \return         jfes_success if everything is OK. jfes_error_part if more bytes expected.
+
+    \warning        A primitive at the end of data is treated as unfinished, so a top-level
+                    primitive value needs a trailing whitespace to be parsed.
+*/
+jfes_status_t jfes_continue_parse_tokens(jfes_parser_t *parser, const char *json,
+    jfes_size_t length, jfes_token_t *tokens, jfes_size_t *max_tokens_count);
+
+#ifdef JFES_USE_THREADS
+/**
+    Runs JSON parser on several threads. Data is split into chunks at commas
+    out of strings, every chunk is parsed into its own tokens and the results
+    are stitched. Tokens, status and parser state are the same as after jfes_parse_tokens.
+    Small data and data which can't be split are parsed on the calling thread.
+
+    \param[in, out] parser              Pointer to the jfes_parser_t object.
+    \param[in]      json                JSON data string.
+    \param[in]      length              JSON data length.
+    \param[out]     tokens              Tokens array to fill.
+    \param[in, out] max_tokens_count    Maximal count of tokens in tokens array.
+                                        Will contain tokens count.
+    \param[in]      threads_count       Count of threads to use, including the calling one.
+
+    \return         jfes_success if everything is OK.
+*/
+jfes_status_t jfes_parse_tokens_parallel(jfes_parser_t *parser, const char *json,
+    jfes_size_t length, jfes_token_t *tokens, jfes_size_t *max_tokens_count, jfes_size_t threads_count);
+#endif
+
+/**
+    JFES SAX parser initialization. The parser doesn't allocate memory:
+    all the memory it needs is passed here.
+
+    \param[out]     parser              Pointer to the jfes_sax_parser_t object.
+    \param[in]      levels              Nesting levels bitset of (`max_depth` + 7) / 8 bytes.
+    \param[in]      max_depth           Maximal nesting depth.
+    \param[in]      buffer              Buffer for the strings and primitives split between chunks.
+                                        Must fit the longest one.
+    \param[in]      buffer_size         Buffer size.
+    \param[in]      callback            Events callback.
+    \param[in]      context             User data for the callback.
+
+    \return         jfes_success if everything is OK.
+*/
+jfes_status_t jfes_init_sax_parser(jfes_sax_parser_t *parser, unsigned char *levels, jfes_size_t max_depth,
+    char *buffer, jfes_size_t buffer_size, jfes_sax_callback_t callback, void *context);
+
+/**
+    Parses the next chunk of JSON data and calls the callback for every event.
+    The chunk can end anywhere, even inside a string.
+
+    \param[in, out] parser              Pointer to the jfes_sax_parser_t object.
+    \param[in]      json                JSON data chunk.
+    \param[in]      length              Chunk length.
+
+    \return         jfes_success if everything is OK. jfes_stopped if the callback stopped parsing.
+                    jfes_no_memory if the data is nested too deep or a value doesn't fit the buffer.
+*/
+jfes_status_t jfes_sax_parse(jfes_sax_parser_t *parser, const char *json, jfes_size_t length);
+
+/**
+    Finishes SAX parsing: the primitive at the end of data is passed to the callback.
+    The parser is ready for the next document after this call.
+
+    \param[in, out] parser              Pointer to the jfes_sax_parser_t object.
+
+    \return         jfes_success if everything is OK. jfes_error_part if the data is incomplete.
+*/
+jfes_status_t jfes_sax_finish(jfes_sax_parser_t *parser);
+
+/**
+    Reads the whole document with the reader and passes it to the SAX parser
+    through the window. jfes_sax_finish is called at the end of data.
+
+    \param[in, out] parser              Pointer to the jfes_sax_parser_t object.
+    \param[in]      reader              Reader callback.
+    \param[in]      context             User data for the reader.
+    \param[in]      window              Buffer for the data.
+    \param[in]      window_size         Buffer size.
+
+    \return         jfes_success if everything is OK. jfes_stopped if the callback stopped parsing.
+*/
+jfes_status_t jfes_sax_parse_reader(jfes_sax_parser_t *parser, jfes_reader_t reader, void *context,
+    char *window, jfes_size_t window_size);
+
+/**
+    Checks that the data is one valid JSON value, possibly surrounded by whitespace.
+    Nothing is stored and nothing is allocated: only the nesting levels are kept.
+    The strict JSON rules are always checked, whether JFES_STRICT is defined or not.
+
+    \param[in]      json                JSON data string.
+    \param[in]      length              JSON data length.
+    \param[in]      levels              Nesting levels bitset of (`max_depth` + 7) / 8 bytes.
+    \param[in]      max_depth           Maximal nesting depth.
+
+    \return         jfes_success if the data is valid. jfes_invalid_input if it is not,
+                    jfes_error_part if the data ends too early and jfes_no_memory
+                    if the nesting is deeper than `max_depth`.
+*/
+jfes_status_t jfes_validate(const char *json, jfes_size_t length, unsigned char *levels, jfes_size_t max_depth);
+
+/**
+    Cursor initialization for the raw data. The data is read only as far as the cursor moves.
+
+    \param[out]     cursor              Pointer to the jfes_cursor_t object.
+    \param[in]      json                JSON data string.
+    \param[in]      length              JSON data length.
+    \param[in]      levels              Nesting levels bitset of (`max_depth` + 7) / 8 bytes.
+    \param[in]      max_depth           Maximal nesting depth.
+
+    \return         jfes_success if everything is OK.
+*/
+jfes_status_t jfes_init_cursor(jfes_cursor_t *cursor, const char *json, jfes_size_t length,
+    unsigned char *levels, jfes_size_t max_depth);
+
+/**
+    Cursor initialization for the reader. The window slides across the data:
+    only the current key or value stays in it, so the longest one must fit into
+    the window. `cursor->value` is valid until the next cursor call.
+
+    \param[out]     cursor              Pointer to the jfes_cursor_t object.
+    \param[in]      reader              Reader callback.
+    \param[in]      context             User data for the reader.
+    \param[in]      window              Buffer for the data.
+    \param[in]      window_size         Buffer size.
+    \param[in]      levels              Nesting levels bitset of (`max_depth` + 7) / 8 bytes.
+    \param[in]      max_depth           Maximal nesting depth.
+
+    \return         jfes_success if everything is OK.
+*/
+jfes_status_t jfes_init_reader_cursor(jfes_cursor_t *cursor, jfes_reader_t reader, void *context,
+    char *window, jfes_size_t window_size, unsigned char *levels, jfes_size_t max_depth);
+
+/**
+    Cursor initialization for the parsed tokens.
+
+    \param[out]     cursor              Pointer to the jfes_cursor_t object.
+    \param[in]      json                JSON data string.
+    \param[in]      length              JSON data length.
+    \param[in]      tokens              Tokens of the data.
+    \param[in]      tokens_count        Tokens count.
+
+    \return         jfes_success if everything is OK.
+*/
+jfes_status_t jfes_init_tokens_cursor(jfes_cursor_t *cursor, const char *json, jfes_size_t length,
+    const jfes_token_t *tokens, jfes_size_t tokens_count);
+
+/**
+    Moves the cursor to the next event: `cursor->event` and `cursor->value`.
+
+    \param[in, out] cursor              Pointer to the jfes_cursor_t object.
+
+    \return         jfes_success if everything is OK. jfes_not_found at the end of data.
+                    jfes_no_memory if the reader value does not fit into the window.
+*/
+jfes_status_t jfes_cursor_next(jfes_cursor_t *cursor);
+
+/**
+    Skips the current object or array, or the value of the current key. The cursor
+    stays at the last event of the skipped value, so jfes_cursor_next moves to the
+    next sibling. Nested containers of the raw data are not validated, and the
+    skipped primitive is not decoded.
+
+    \param[in, out] cursor              Pointer to the jfes_cursor_t object.
+
+    \return         jfes_success if everything is OK.
+*/
+jfes_status_t jfes_cursor_skip(jfes_cursor_t *cursor);
+
+/**
+    Moves the cursor from the object or array start to its first key or item.
+
+    \param[in, out] cursor              Pointer to the jfes_cursor_t object.
+
+    \return         jfes_success if everything is OK. jfes_not_found if the container is empty:
+                    the cursor is at its end. jfes_wrong_type if the cursor is not at a container start.
+*/
+jfes_status_t jfes_cursor_enter(jfes_cursor_t *cursor);
+
+/**
+    Moves the cursor from the object start to the value of the key. Values of the
+    other keys are skipped.
+
+    \param[in, out] cursor              Pointer to the jfes_cursor_t object.
+    \param[in]      key                 Key to find. Escape sequences are not decoded.
+    \param[in]      key_length          Key length. Can be 0: will be calculated by jfes_strlen.
+
+    \return         jfes_success if everything is OK. jfes_not_found if there is no such key:
+                    the cursor is at the object end. jfes_wrong_type if the cursor is not at an object start.
+*/
+jfes_status_t jfes_cursor_find(jfes_cursor_t *cursor, const char *key, jfes_size_t key_length);
+
+/**
+    Path matcher initialization.
+
+    \param[out]     matcher             Pointer to the jfes_matcher_t object.
+    \param[in]      nodes               Array of nodes: one for the root and one per reference
+                                        token of the paths, shared prefixes are stored once.
+    \param[in]      max_nodes_count     Nodes array size.
+
+    \return         jfes_success if everything is OK.
+*/
+jfes_status_t jfes_init_matcher(jfes_matcher_t *matcher, jfes_path_node_t *nodes, jfes_size_t max_nodes_count);
+
+/**
+    Adds the JSON Pointer (RFC 6901) to the matcher. The `*` reference token
+    matches any key or index of its level. The pointer is not copied: it must
+    be valid while the matcher is used.
+
+    \param[in, out] matcher             Pointer to the jfes_matcher_t object.
+    \param[in]      pointer             JSON Pointer. Empty string means the root value.
+    \param[in]      pointer_length      Optional. Pointer length. You can pass 0
+                                        if the pointer is zero-terminated.
+    \param[out]     path                Optional. Index of the path for the callback.
+                                        The same pointer added twice has the same index.
+
+    \return         jfes_success if everything is OK. jfes_no_memory if there are not enough nodes.
+                    jfes_invalid_arguments if the pointer is malformed, e.g. `~` is not followed by `0` or `1`.
+*/
+jfes_status_t jfes_matcher_add(jfes_matcher_t *matcher, const char *pointer, jfes_size_t pointer_length,
+    jfes_size_t *path);
+
+/**
+    Reads the next value from the cursor and calls the callback for every path
+    it matches, in the document order. Subtrees which no path leads into are skipped
+    without reading their values.
+
+    \param[in]      matcher             Pointer to the jfes_matcher_t object.
+    \param[in, out] cursor              Cursor before the value: just initialized or at the end of the previous one.
+    \param[in]      states              Matching states array of `matcher->nodes_count` items.
+    \param[in]      callback            Callback for the matches. It must not move the cursor.
+    \param[in]      context             User data for the callback.
+
+    \return         jfes_success if everything is OK. jfes_stopped if the callback stopped matching.
+                    jfes_not_found if there is no more values.
+*/
+jfes_status_t jfes_match(const jfes_matcher_t *matcher, jfes_cursor_t *cursor, int *states,
+    jfes_match_callback_t callback, void *context);
+
+/**
+    Reads the next object from the cursor straight into the struct. Keys which are not
+    in the fields table are skipped without decoding, missing keys and null values
+    leave the fields as they are.
+
+    \param[in, out] cursor              Cursor before the object: just initialized or at the end of the previous value.
+    \param[in]      fields              Fields table of the struct.
+    \param[out]     data                Pointer to the struct.
+
+    \return         jfes_success if everything is OK. jfes_wrong_type if the value doesn't fit the field.
+                    jfes_no_memory if a string or an array is longer than the field.
+*/
+jfes_status_t jfes_read_struct(jfes_cursor_t *cursor, const jfes_field_t *fields, void *data);
+
+/**
+    Converts tokens into the compact form. Compact tokens store only the type,
+    the start position and the index of the token after the subtree, so any
+    value can be skipped in constant time.
+
+    \param[in]      tokens              Tokens to convert.
+    \param[in]      tokens_count        Tokens count.
+    \param[out]     compact_tokens      Compact tokens array with `tokens_count` items.
+
+    \return         jfes_success if everything is OK. jfes_invalid_arguments if
+                    some token starts after JFES_COMPACT_MAX_START.
+*/
+jfes_status_t jfes_compact_tokens(const jfes_token_t *tokens, jfes_size_t tokens_count,
+    jfes_compact_token_t *compact_tokens);
+
+/**
+    Restores tokens from the compact form. Token ends are found in the JSON data.
+
+    \param[in]      json                JSON data string.
+    \param[in]      length              JSON data length.
+    \param[in]      compact_tokens      Compact tokens.
+    \param[in]      tokens_count        Tokens count.
+    \param[out]     tokens              Tokens array with `tokens_count` items.
+
+    \return         jfes_success if everything is OK.
+*/
+jfes_status_t jfes_expand_tokens(const char *json, jfes_size_t length,
+    const jfes_compact_token_t *compact_tokens, jfes_size_t tokens_count, jfes_token_t *tokens);
+
+/**
+    Returns type of the compact token.
+
+    \param[in]      token               Compact token.
+
+    \return         Token type.
+*/
+jfes_token_type_t jfes_compact_token_type(const jfes_compact_token_t *token);
+
+/**
+    Returns start position of the compact token.
+
+    \param[in]      token               Compact token.
+
+    \return         Token start position.
+*/
+jfes_size_t jfes_compact_token_start(const jfes_compact_token_t *token);
+
+/**
+    Finds a token by the JSON Pointer (RFC 6901), e.g. `/users/3/name`.
+    Skipped values are not converted, nothing is allocated.
+
+    \param[in]      tokens_data         Tokens of the parsed JSON data.
+    \param[in]      pointer             JSON Pointer. Empty string means the root value.
+                                        Escape sequences of the object keys are decoded.
+    \param[in]      pointer_length      Optional. Pointer length. You can pass 0
+                                        if the pointer is zero-terminated.
+    \param[out]     index               Index of the found token.
+
+    \return         jfes_success if everything is OK. jfes_not_found if there is no such value.
+                    jfes_invalid_arguments if the pointer is malformed, e.g. `~` is not followed by `0` or `1`.
+*/
+jfes_status_t jfes_find_token(const jfes_tokens_data_t *tokens_data, const char *pointer,
+    jfes_size_t pointer_length, jfes_size_t *index);
+
+/**
+    Reads an integer value by the JSON Pointer without building values.
+
+    \param[in]      tokens_data         Tokens of the parsed JSON data.
+    \param[in]      pointer             JSON Pointer.
+    \param[in]      pointer_length      Optional. Pointer length. You can pass 0
+                                        if the pointer is zero-terminated.
+    \param[out]     value               Integer value.
+
+    \return         jfes_success if everything is OK. jfes_wrong_type if the value is not an integer.
+*/
+jfes_status_t jfes_get_integer(const jfes_tokens_data_t *tokens_data, const char *pointer,
+    jfes_size_t pointer_length, jfes_integer_t *value);
+
+/**
+    Reads a double value by the JSON Pointer without building values.
+    Integer values are converted to double.
+
+    \param[in]      tokens_data         Tokens of the parsed JSON data.
+    \param[in]      pointer             JSON Pointer.
+    \param[in]      pointer_length      Optional. Pointer length. You can pass 0
+                                        if the pointer is zero-terminated.
+    \param[out]     value               Double value.
+
+    \return         jfes_success if everything is OK. jfes_wrong_type if the value is not a number.
+*/
+jfes_status_t jfes_get_double(const jfes_tokens_data_t *tokens_data, const char *pointer,
+    jfes_size_t pointer_length, double *value);
+
+/**
+    Reads a boolean value by the JSON Pointer without building values.
+
+    \param[in]      tokens_data         Tokens of the parsed JSON data.
+    \param[in]      pointer             JSON Pointer.
+    \param[in]      pointer_length      Optional. Pointer length. You can pass 0
+                                        if the pointer is zero-terminated.
+    \param[out]     value               Boolean value.
+
+    \return         jfes_success if everything is OK. jfes_wrong_type if the value is not a boolean.
+*/
+jfes_status_t jfes_get_boolean(const jfes_tokens_data_t *tokens_data, const char *pointer,
+    jfes_size_t pointer_length, int *value);
+
+/**
+    Finds a string value by the JSON Pointer without copying it.
+
+    \param[in]      tokens_data         Tokens of the parsed JSON data.
+    \param[in]      pointer             JSON Pointer.
+    \param[in]      pointer_length      Optional. Pointer length. You can pass 0
+                                        if the pointer is zero-terminated.
+    \param[out]     data                Pointer to the string bytes inside JSON data.
+                                        The string is not zero-terminated and escapes are not decoded.
+    \param[out]     length              String length.
+
+    \return         jfes_success if everything is OK. jfes_wrong_type if the value is not a string.
+*/
+jfes_status_t jfes_get_string_view(const jfes_tokens_data_t *tokens_data, const char *pointer,
+    jfes_size_t pointer_length, const char **data, jfes_size_t *length);
+
 /**
     Runs JSON parser and fills jfes_value_t object.
 
@@ -208,6 +795,75 @@ jfes_status_t jfes_parse_tokens(jfes_parser_t *parser, const char *json,
 jfes_status_t jfes_parse_to_value(const jfes_config_t *config, const char *json,
     jfes_size_t length, jfes_value_t *value);
 
+/**
+    Runs JSON parser and fills jfes_value_t object in situ: strings and keys are not allocated,
+    they point into the JSON data. Escape sequences are decoded in place and closing quotes
+    are replaced by zeros, so the data is changed. Keep the data until the value is freed.
+
+    \param[in]      config              JFES configuration.
+    \param[in, out] json                Writable JSON data string.
+    \param[in]      length              JSON data length.
+    \param[out]     value               Output value.
+
+    \return         jfes_success if everything is OK.
+*/
+jfes_status_t jfes_parse_to_value_in_situ(const jfes_config_t *config, char *json,
+    jfes_size_t length, jfes_value_t *value);
+
+/**
+    Runs JSON parser and fills jfes_value_t object only with the values which the matcher
+    paths end at and their parents. Other subtrees are skipped by tokens without building values.
+    Arrays keep only the matched items, so their indices can change.
+
+    \param[in]      config              JFES configuration.
+    \param[in]      json                JSON data string.
+    \param[in]      length              JSON data length.
+    \param[in]      matcher             Paths to build, see jfes_matcher_add.
+    \param[out]     value               Output value.
+
+    \return         jfes_success if everything is OK. jfes_not_found if the root value is
+                    a primitive and no path ends at it.
+*/
+jfes_status_t jfes_parse_to_projected_value(const jfes_config_t *config, const char *json, jfes_size_t length,
+    const jfes_matcher_t *matcher, jfes_value_t *value);
+
+#ifdef JFES_USE_MMAP
+/**
+    Maps the file into memory read-only. The data is not copied: pages are read
+    by the system when they are touched, so the file can be tokenized, parsed or
+    read by the cursor right from the mapping. Tokens, cursor values and string
+    views point into the mapping, so keep it until they are not needed.
+
+    \param[in]      filename            Path to the file.
+    \param[out]     file                Mapped file.
+
+    \return         jfes_success if everything is OK. jfes_not_found if the file can't be opened.
+                    jfes_no_memory if the file can't be mapped or is longer than jfes_size_t.
+*/
+jfes_status_t jfes_map_file(const char *filename, jfes_mapped_file_t *file);
+
+/**
+    Unmaps the file mapped by jfes_map_file.
+
+    \param[in, out] file                Mapped file.
+
+    \return         jfes_success if everything is OK.
+*/
+jfes_status_t jfes_unmap_file(jfes_mapped_file_t *file);
+
+/**
+    Maps the file and parses it into jfes_value_t object. Values keep their own
+    copies of the data, so the file is unmapped before return.
+
+    \param[in]      config              JFES configuration.
+    \param[in]      filename            Path to the JSON file.
+    \param[out]     value               Output value.
+
+    \return         jfes_success if everything is OK.
+*/
+jfes_status_t jfes_parse_file_to_value(const jfes_config_t *config, const char *filename, jfes_value_t *value);
+#endif
+
 /**
     Frees all resources captured by the object.
 
@@ -218,6 +874,47 @@ jfes_status_t jfes_parse_to_value(const jfes_config_t *config, const char *json,
 */
 jfes_status_t jfes_free_value(const jfes_config_t *config, jfes_value_t *value);
 
+#ifdef JFES_USE_THREADS
+/**
+    Callback for the records of JSON Lines. Called on the calling thread in the records order.
+
+    \param[in]      context             User data passed to jfes_parse_lines.
+    \param[in]      index               Record index. Empty lines are not counted.
+    \param[in]      status              Record parsing status.
+    \param[in, out] value               Record value or JFES_NULL if the record is invalid.
+                                        It is freed after the callback returns. To keep it,
+                                        copy the value and set `value->type` to `jfes_type_null`.
+
+    \return         Zero to stop parsing. Anything otherwise.
+*/
+typedef int (*jfes_record_callback_t)(void *context, jfes_size_t index, jfes_status_t status, jfes_value_t *value);
+
+/** JSON Lines parsing statistics. */
+typedef struct jfes_lines_stats {
+    jfes_size_t             records_count;      /**< Count of the records passed to the callback. */
+    jfes_size_t             errors_count;       /**< Count of the invalid records. */
+    double                  seconds;            /**< Wall clock parsing time. */
+    double                  records_per_second; /**< Parsing throughput. */
+} jfes_lines_stats_t;
+
+/**
+    Parses newline-delimited JSON (JSON Lines): every non-empty line is a separate value.
+    Records are parsed by batches on a pool of threads, each thread reuses its own tokens.
+
+    \param[in]      config              JFES configuration. Allocator must be thread-safe.
+    \param[in]      json                JSON Lines data.
+    \param[in]      length              Data length.
+    \param[in]      threads_count       Count of threads to use, including the calling one.
+    \param[in]      callback            Function to call for every record.
+    \param[in]      context             User data for the callback.
+    \param[out]     stats               Parsing statistics. Can be JFES_NULL.
+
+    \return         jfes_success if all the data was processed or the callback stopped parsing.
+*/
+jfes_status_t jfes_parse_lines(const jfes_config_t *config, const char *json, jfes_size_t length,
+    jfes_size_t threads_count, jfes_record_callback_t callback, void *context, jfes_lines_stats_t *stats);
+#endif
+
 /**
     Allocates a new null value.
 
@@ -245,7 +942,7 @@ jfes_value_t *jfes_create_boolean_value(const jfes_config_t *config, int value);
 
     \return         Allocated JFES value or JFES_NULL if something went wrong.
 */
-jfes_value_t *jfes_create_integer_value(const jfes_config_t *config, int value);
+jfes_value_t *jfes_create_integer_value(const jfes_config_t *config, jfes_integer_t value);
 
 /**
     Allocates a new double value.
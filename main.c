@@ -10,9 +10,14 @@
 
 /* Only for file functions. */
 #include <stdio.h>
+#include <string.h>
 
 /** Entry point. */
 int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "benchmark") == 0) {
+        return benchmark_entry(argc - 1, argv + 1);
+    }
+
     return example_3_entry(argc, argv);
 }
 